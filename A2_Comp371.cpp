@@ -3,95 +3,285 @@
 //               2. Zexu Hao 40233332
 //               3. Mingming Zhang 40258080
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h> // GetMessageTime, for input latency
+#endif
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+// SSE2 and up where the compiler targets them; the plain glm types keep
+// their layout, only the image conversions of video_capture.h use it
+#define GLM_FORCE_INTRINSICS
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
-// Coordinate system: the Z-axis points upwards
-// Modified vertex shader to add color input and pass it to the fragment shader
-const char* vertexShaderSource = R"glsl(
-    #version 330 core
-    layout (location = 0) in vec3 aPos;
-    layout (location = 1) in vec3 aColor; // Add color attribute
-    out vec3 vertexColor; // Output color to fragment shader
-    uniform mat4 transform;
-    void main() {
-        gl_Position = transform * vec4(aPos, 1.0);
-        vertexColor = aColor; // Pass color
-    }
-)glsl";
-
-// Modified fragment shader to use vertex color
-const char* fragmentShaderSource = R"glsl(
-    #version 330 core
-    in vec3 vertexColor; // Receive color from vertex shader
-    out vec4 FragColor;
-    void main() {
-        FragColor = vec4(vertexColor, 1.0f); // Use vertex color
-    }
-)glsl";
+#include <memory>
+#include <string>
+#include <vector>
+#include "clustered_lights.h"
+#include "clustered_lights_gl.h"
+#include "command_list.h"
+#include "command_replay_gl.h"
+#include "dynamic_resolution.h"
+#include "dynamic_resolution_gl.h"
+#include "frame_capture.h"
+#include "frame_capture_gl.h"
+#include "frame_pacing.h"
+#include "frame_queue_gl.h"
+#include "frame_stats.h"
+#include "gltf_loader.h"
+#include "gpu_mesh.h"
+#include "input_replay.h"
+#include "job_system.h"
+#include "mesh_format.h"
+#include "mesh_import.h"
+#include "mesh_optimize.h"
+#include "meshlet.h"
+#include "meshlet_cull_gl.h"
+#include "procedural_pyramid_gl.h"
+#include "pyramid_gen.h"
+#include "pyramid_gen_gl.h"
+#include "scene.h"
+#include "scene_shaders.h"
+#include "shader_cache_gl.h"
+#include "shadow_cascades.h"
+#include "shadow_cascades_gl.h"
+#include "uniform_blocks.h"
+#include "uniform_blocks_gl.h"
+#include "video_capture.h"
+
+// Keyboard and window state for the simulation. Live key events update `state`
+// (and the recorder when recording); during a replay the recorded events drive it instead.
+struct InputContext {
+    InputState state;
+    InputRecorder recorder;
+    bool recording = false;
+    bool replaying = false;
+    uint32_t tick = 0; // Simulation tick the next polled events belong to
+    double startTime = 0.0;
+    bool redraw = true; // Set by any event that changes what is on screen, for --idle
+    int framebufferWidth = 0;
+    int framebufferHeight = 0;
+    std::vector<double> keyPressTimes; // Live presses no frame has seen yet, for --latency-log
+};
+
+// When a key event happened, in glfwGetTime seconds. On Windows this is the
+// message time, so the time the event waited to be polled is included (at the
+// system tick resolution); elsewhere GLFW only tells when the callback ran.
+double keyEventTime() {
+#ifdef _WIN32
+    DWORD age = GetTickCount() - static_cast<DWORD>(GetMessageTime());
+    return glfwGetTime() - age / 1000.0;
+#else
+    return glfwGetTime();
+#endif
+}
+
+void keyCallback(GLFWwindow* window, int key, int /*scancode*/, int action, int /*mods*/) {
+    InputContext* input = static_cast<InputContext*>(glfwGetWindowUserPointer(window));
+    if (action == GLFW_REPEAT)
+        return;
+    input->redraw = true;
+    if (input->replaying) {
+        // The live keyboard is ignored during a replay, except to abort it
+        if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
+            glfwSetWindowShouldClose(window, true);
+        return;
+    }
+    input->state.set(key, action == GLFW_PRESS);
+    if (action == GLFW_PRESS)
+        input->keyPressTimes.push_back(keyEventTime());
+    if (input->recording) {
+        uint64_t timeMicros = static_cast<uint64_t>((glfwGetTime() - input->startTime) * 1e6);
+        input->recorder.record(input->tick, key, action, timeMicros);
+    }
+}
+
+// Exposed, resized or restored: the window contents must be drawn again
+void windowRefreshCallback(GLFWwindow* window) {
+    static_cast<InputContext*>(glfwGetWindowUserPointer(window))->redraw = true;
+}
+
+// The viewport, projection and render target follow this size from the next frame
+void framebufferSizeCallback(GLFWwindow* window, int width, int height) {
+    InputContext* input = static_cast<InputContext*>(glfwGetWindowUserPointer(window));
+    input->framebufferWidth = width;
+    input->framebufferHeight = height;
+    input->redraw = true;
+}
 
 // Modify processInput function to handle W, S, A, D keys
-void processInput(GLFWwindow* window, glm::vec3& translation, float& rotationAngle,
+void processInput(GLFWwindow* window, const InputState& input, glm::vec3& translation, float& rotationAngle,
     bool& rotationPending,float& scaleZ) {
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+    if (input.isDown(GLFW_KEY_ESCAPE))
         glfwSetWindowShouldClose(window, true);
 
     const float moveSpeed = 0.001f; // Movement speed
     const float rotationSpeed = glm::radians(30.0f); // Rotation speed (30 degrees converted to radians)
     // Translation controls
     //Press W -> move up along +ve z-axis
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
+    if (input.isDown(GLFW_KEY_W))
         translation.z += moveSpeed; 
     //Press S -> move down along -ve z-axis
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
+    if (input.isDown(GLFW_KEY_S))
         translation.z -= moveSpeed; 
     //Press A -> move horizontally left along +ve x-axis & -ve y-axis
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) {
+    if (input.isDown(GLFW_KEY_A)) {
         translation.x += moveSpeed; 
         translation.y -= moveSpeed;
     }
     //Press D -> move horizontally right along -ve x-axis & +ve y-axis
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) {
+    if (input.isDown(GLFW_KEY_D)) {
         translation.x -= moveSpeed; 
         translation.y += moveSpeed;
     }
 
     // Rotation controls
      // Press Q -> Counterclockwise rotation by 30° (ensure execution only once)
-    if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS && !rotationPending) {
+    if (input.isDown(GLFW_KEY_Q) && !rotationPending) {
         rotationAngle -= 30.0f;
         rotationPending = true; // Mark rotation as completed to avoid repeated execution
     }
 
     // Press E -> Clockwise rotation by 30° (ensure execution only once)
-    if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS && !rotationPending) {
+    if (input.isDown(GLFW_KEY_E) && !rotationPending) {
         rotationAngle += 30.0f;
         rotationPending = true; // Mark rotation as completed to avoid repeated execution
     }
 
     // When keys are released, reset rotationPending to allow the next rotation
-    if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_RELEASE && glfwGetKey(window, GLFW_KEY_E) == GLFW_RELEASE) {
+    if (!input.isDown(GLFW_KEY_Q) && !input.isDown(GLFW_KEY_E)) {
         rotationPending = false;
     }
 
     // Scaling controls
     // Press R -> Scale in the +z direction
-    if (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS) {
+    if (input.isDown(GLFW_KEY_R)) {
         scaleZ += 0.001f; // Increase scale factor (small increment)
         if (scaleZ > 5.0f) scaleZ = 5.0f; // Limit maximum value
     }
 
     // Press F -> Scale in the -z direction
-    if (glfwGetKey(window, GLFW_KEY_F) == GLFW_PRESS) {
+    if (input.isDown(GLFW_KEY_F)) {
         scaleZ -= 0.001f; // Decrease scale factor (small increment)
         if (scaleZ < 0.1f) scaleZ = 0.1f; // Limit minimum value
     }
 }
 
-int main() {
+// Command line options
+struct AppOptions {
+    int gridSize = 0;                // --grid N: N x N extra spinning pyramids
+    unsigned int workerThreads = 0;  // --threads N: job system workers, 0 = one per core
+    bool printJobStats = false;      // --job-stats: print average job times every 120 frames
+    std::string recordPath;          // --record FILE: save keyboard input for later replay
+    std::string replayPath;          // --replay FILE: drive the simulation from a recording
+    std::string frameTimesPath;      // --frame-times FILE: write per-frame times as CSV
+    bool headless = false;           // --headless: render to a hidden window
+    int frameLimit = 0;              // --frames N: render N fixed-step frames, then exit (0 = until closed)
+    std::string meshPath;            // --mesh FILE: draw a .pmesh, .obj, .ply, .gltf or .glb file instead of the pyramid
+    bool meshlets = false;           // --meshlets: cull meshlets of the mesh on the GPU (OpenGL 4.3)
+    PyramidGenParams pyramid;        // --sides N, --sierpinski DEPTH: generated pyramid instead of the built-in one
+    bool generatePyramid = false;
+    bool procedural = false;         // --procedural: build the pyramids in the vertex shader, no vertex buffers
+    bool idle = false;               // --idle: wait for events instead of redrawing frames that would not change
+    double fpsCap = 0.0;             // --fps-cap N: at most N frames per second, 0 = no cap
+    float dynamicResolutionMs = 0.0f; // --dynamic-resolution MS: scale the render size to keep GPU frames near MS
+    float sharpness = 0.25f;         // --sharpen X: unsharp mask strength when upscaling, 0 = bilinear only
+    int swapInterval = 1;            // --swap-interval N: 0 = no vsync, 1 = every refresh, -1 = adaptive
+    bool setSwapInterval = false;
+    bool lateInput = false;          // --late-input: poll events right before simulating instead of after the swap
+    int maxFramesInFlight = -1;      // --max-frames-in-flight N: 0 = glFinish after each swap, -1 = driver default
+    std::string latencyLogPath;      // --latency-log FILE: write key press to swap times as CSV
+    int lightCount = 0;              // --lights N: N moving point lights, clustered forward shading (OpenGL 4.3)
+    bool shadows = false;            // --shadows: a sun with cascaded shadow maps (OpenGL 4.3, lit shading)
+    std::string capturePrefix;       // --capture PREFIX: save frames as PREFIX_NNNNNN.png without stalling
+    int captureEvery = 1;            // --capture-every N: capture every Nth frame
+    CaptureFormat captureFormat = CaptureFormat::Png; // --capture-format png|raw
+    std::string videoPath;           // --video FILE: record the frames as a .y4m (or raw 4:2:0) stream
+    VideoFormat videoFormat = VideoFormat::Yuv420; // --video-format yuv420|ycocg420
+    int videoFps = 60;               // --video-fps N: frame rate written to the Y4M header
+};
+
+AppOptions parseOptions(int argc, char** argv) {
+    AppOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--grid" && hasValue)
+            options.gridSize = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--threads" && hasValue)
+            options.workerThreads = static_cast<unsigned int>(std::max(0, std::atoi(argv[++i])));
+        else if (arg == "--job-stats")
+            options.printJobStats = true;
+        else if (arg == "--record" && hasValue)
+            options.recordPath = argv[++i];
+        else if (arg == "--replay" && hasValue)
+            options.replayPath = argv[++i];
+        else if (arg == "--frame-times" && hasValue)
+            options.frameTimesPath = argv[++i];
+        else if (arg == "--headless")
+            options.headless = true;
+        else if (arg == "--frames" && hasValue)
+            options.frameLimit = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--mesh" && hasValue)
+            options.meshPath = argv[++i];
+        else if (arg == "--meshlets")
+            options.meshlets = true;
+        else if (arg == "--procedural")
+            options.procedural = true;
+        else if (arg == "--idle")
+            options.idle = true;
+        else if (arg == "--fps-cap" && hasValue)
+            options.fpsCap = std::max(0.0, std::atof(argv[++i]));
+        else if (arg == "--dynamic-resolution" && hasValue)
+            options.dynamicResolutionMs = std::max(0.0f, static_cast<float>(std::atof(argv[++i])));
+        else if (arg == "--sharpen" && hasValue)
+            options.sharpness = std::max(0.0f, static_cast<float>(std::atof(argv[++i])));
+        else if (arg == "--swap-interval" && hasValue) {
+            options.swapInterval = std::atoi(argv[++i]);
+            options.setSwapInterval = true;
+        } else if (arg == "--late-input")
+            options.lateInput = true;
+        else if (arg == "--max-frames-in-flight" && hasValue)
+            options.maxFramesInFlight = std::max(-1, std::atoi(argv[++i]));
+        else if (arg == "--latency-log" && hasValue)
+            options.latencyLogPath = argv[++i];
+        else if (arg == "--lights" && hasValue)
+            options.lightCount = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--shadows")
+            options.shadows = true;
+        else if (arg == "--capture" && hasValue)
+            options.capturePrefix = argv[++i];
+        else if (arg == "--capture-every" && hasValue)
+            options.captureEvery = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--capture-format" && hasValue)
+            options.captureFormat = std::string(argv[++i]) == "raw" ? CaptureFormat::Raw : CaptureFormat::Png;
+        else if (arg == "--video" && hasValue)
+            options.videoPath = argv[++i];
+        else if (arg == "--video-format" && hasValue)
+            options.videoFormat = std::string(argv[++i]) == "ycocg420" ? VideoFormat::YCoCg420 : VideoFormat::Yuv420;
+        else if (arg == "--video-fps" && hasValue)
+            options.videoFps = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--sides" && hasValue) {
+            options.pyramid.sides = static_cast<uint32_t>(std::max(0, std::atoi(argv[++i])));
+            options.generatePyramid = true;
+        } else if (arg == "--sierpinski" && hasValue) {
+            options.pyramid.depth = static_cast<uint32_t>(std::max(0, std::atoi(argv[++i])));
+            options.generatePyramid = true;
+        }
+        else
+            std::cerr << "Unknown option: " << arg << std::endl;
+    }
+    return options;
+}
+
+int main(int argc, char** argv) {
+    AppOptions options = parseOptions(argc, argv);
+
    // Initialize GLFW and create a window (unchanged)
     if (!glfwInit()) {
         std::cerr << "Failed to initialize GLFW" << std::endl;
@@ -100,6 +290,7 @@ int main() {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, options.headless ? GLFW_FALSE : GLFW_TRUE);
 
     GLFWwindow* window = glfwCreateWindow(800, 600, "Pyramid with OpenGL", NULL, NULL);
     if (!window) {
@@ -113,84 +304,177 @@ int main() {
         std::cerr << "Failed to initialize GLEW" << std::endl;
         return -1;
     }
-
-    // Define vertex data with color attributes
-    float vertices[] = {
-        // Position (x, y, z)         // Color (r, g, b)
-        -0.5f, -0.5f, 0.0f,      1.0f, 0.0f, 0.0f, // Bottom left - Red
-         0.5f, -0.5f, 0.0f,      0.0f, 1.0f, 0.0f, // Bottom right - Green
-         0.5f,  0.5f, 0.0f,      0.0f, 0.0f, 1.0f, // Top right - Blue
-        -0.5f,  0.5f, 0.0f,      1.0f, 1.0f, 0.0f, // Top left - Yellow
-         0.0f,  0.0f, 1.0f,      1.0f, 0.5f, 0.2f  // Peak - Orange
-    };
-
-    unsigned int indices[] = {
-        0, 1, 2,  // Base triangle 1
-        2, 3, 0,  // Base triangle 2
-        0, 1, 4,  // Front face
-        1, 2, 4,  // Right face
-        2, 3, 4,  // Back face
-        3, 0, 4   // Left face
-    };
-
-  // Create VBO, VAO, EBO
-    unsigned int VBO, VAO, EBO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
-
-    glBindVertexArray(VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
- 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-
-
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-    glCompileShader(vertexShader);
-    int success;
-    char infoLog[512];
-    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-        std::cerr << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
+    // Without the option the driver's default (usually vsync) applies
+    if (options.setSwapInterval)
+        glfwSwapInterval(options.swapInterval);
+
+    JobSystem jobs(options.workerThreads);
+
+    // Geometry: the built-in pyramid, a .pmesh file uploaded straight from
+    // its memory mapping (see mesh_convert), an imported OBJ/PLY file, or a
+    // glTF scene whose buffer views are uploaded as they are
+    GpuMesh mesh;
+    GltfModel gltfModel;
+    std::vector<Meshlet> meshlets; // Of LOD 0, only built for --meshlets
+    if (hasExtension(options.meshPath, ".gltf") || hasExtension(options.meshPath, ".glb")) {
+        std::string error;
+        if (!loadGltf(options.meshPath, jobs, gltfModel, error)) {
+            std::cerr << "Failed to load glTF " << options.meshPath << ": " << error << std::endl;
+            glfwTerminate();
+            return -1;
+        }
+    } else if (hasExtension(options.meshPath, ".obj") || hasExtension(options.meshPath, ".ply")) {
+        MeshData imported;
+        std::string error;
+        if (!importMeshFile(options.meshPath, jobs, imported, error)) {
+            std::cerr << "Failed to import mesh " << options.meshPath << ": " << error << std::endl;
+            glfwTerminate();
+            return -1;
+        }
+        MeshOptimizeReport report = optimizeMesh(imported);
+        std::cout << "Mesh " << options.meshPath << ": ACMR " << report.before.acmr << " -> " << report.after.acmr
+            << ", ATVR " << report.before.atvr << " -> " << report.after.atvr << std::endl;
+        mesh = uploadMesh(imported);
+        if (options.meshlets)
+            meshlets = buildMeshlets(imported, mesh.lods[0].firstIndex, mesh.lods[0].indexCount, jobs);
+    } else if (!options.meshPath.empty()) {
+        MappedFile meshFile;
+        MeshFileView meshView;
+        std::string error = "cannot open file";
+        if (!meshFile.open(options.meshPath) || !openMeshFile(meshFile, meshView, error)) {
+            std::cerr << "Failed to load mesh " << options.meshPath << ": " << error << std::endl;
+            glfwTerminate();
+            return -1;
+        }
+        mesh = uploadMeshFile(meshView);
+        MeshData meshData;
+        if (options.meshlets && readMeshData(meshView, meshData, error))
+            meshlets = buildMeshlets(meshData, mesh.lods[0].firstIndex, mesh.lods[0].indexCount, jobs);
+        else if (options.meshlets)
+            std::cerr << "No meshlets for " << options.meshPath << ": " << error << std::endl;
+    } else if (options.generatePyramid) {
+        if (!validPyramidParams(options.pyramid)) {
+            std::cerr << "Invalid pyramid: " << options.pyramid.sides << " sides, depth " << options.pyramid.depth
+                << std::endl;
+            glfwTerminate();
+            return -1;
+        }
+        double start = glfwGetTime();
+        if (options.meshlets) {
+            // Meshlets are built from the indices, so keep a CPU copy
+            MeshData generated = generateSierpinski(options.pyramid, jobs);
+            mesh = uploadMesh(generated);
+            meshlets = buildMeshlets(generated, 0, static_cast<uint32_t>(generated.indices.size()), jobs);
+        } else {
+            mesh = uploadSierpinski(options.pyramid, jobs);
+        }
+        std::cout << "Generated " << mesh.indexCount / 3 << " triangles in " << (glfwGetTime() - start) * 1000.0
+            << " ms" << std::endl;
+    } else {
+        MeshData pyramid = makePyramidMesh();
+        mesh = uploadMesh(pyramid);
+        if (options.meshlets)
+            meshlets = buildMeshlets(pyramid, mesh.lods[0].firstIndex, mesh.lods[0].indexCount, jobs);
     }
 
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-    glCompileShader(fragmentShader);
-    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-        std::cerr << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
+    // Every scene draw binds a program specialized for its features, built
+    // the first time a draw asks for that permutation
+    const bool lightingRequested = options.lightCount > 0 || options.shadows;
+    const bool lightingMode = lightingRequested && ClusteredLighting::isSupported();
+    if (lightingRequested && !lightingMode)
+        std::cerr << "Clustered lighting needs OpenGL 4.3, drawing unlit" << std::endl;
+    ShaderCache shaderCache;
+    shaderCache.init(SCENE_VERTEX_SHADER_TEMPLATE, SCENE_FRAGMENT_SHADER_TEMPLATE);
+    // Features every scene program shares: lighting, then shadows below
+    uint32_t sceneFeatures = lightingMode ? SHADER_LIGHTING : 0;
+
+    // Everything drawn per instance: the mesh's draw, or one per glTF primitive
+    std::vector<DrawItem> draws;
+    MaterialTable materials;
+    std::vector<uint32_t> materialSlots; // Per instanced draw, until the table is uploaded
+    glm::vec3 boundsCenter;
+    float boundsRadius;
+    unsigned int meshletProgram = 0;
+    MeshletCuller meshletCuller;
+    bool meshletMode = false;
+    ProceduralPyramidRenderer proceduralRenderer;
+    const bool proceduralMode = options.procedural && options.meshPath.empty() && !options.generatePyramid &&
+        meshlets.empty();
+    if (options.procedural && !proceduralMode)
+        std::cerr << "--procedural only draws the built-in pyramid, ignoring it" << std::endl;
+    // Shadows need recorded casters, which procedural and meshlet draws have none of
+    const bool shadowsMode = lightingMode && options.shadows && !proceduralMode &&
+        (meshlets.empty() || !MeshletCuller::isSupported());
+    if (options.shadows && lightingMode && !shadowsMode)
+        std::cerr << "Procedural and meshlet modes cast no shadows" << std::endl;
+    if (shadowsMode)
+        sceneFeatures |= SHADER_SHADOWS;
+    if (!meshlets.empty() && !MeshletCuller::isSupported()) {
+        std::cerr << "Meshlet culling needs OpenGL 4.3, drawing whole meshes" << std::endl;
+    } else if (!meshlets.empty()) {
+        // GPU-driven: the compute pass decides what is drawn, no DrawItems
+        meshletProgram = shaderCache.get(SHADER_INSTANCED | sceneFeatures);
+        meshletMode = meshletCuller.init(mesh, meshlets);
+        std::cout << meshlets.size() << " meshlets per instance" << std::endl;
     }
-
-    unsigned int shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-        std::cerr << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+    if (meshletMode) {
+        boundsCenter = mesh.boundsCenter;
+        boundsRadius = mesh.boundsRadius;
+    } else if (proceduralMode) {
+        // Nothing recorded per instance, the vertex shader reads every visible one
+        shaderCache.setVertexTemplate(SHADER_PROCEDURAL, ProceduralPyramidRenderer::vertexShaderSource());
+        proceduralRenderer.init(shaderCache.get(SHADER_PROCEDURAL | sceneFeatures));
+        boundsCenter = mesh.boundsCenter;
+        boundsRadius = mesh.boundsRadius;
+    } else if (gltfModel.draws.empty()) {
+        DrawItem draw;
+        draw.program = shaderCache.get((isQuantized(mesh.vertexFormat) ? SHADER_QUANTIZED : 0) | sceneFeatures);
+        draw.transformLocation = glGetUniformLocation(draw.program, "transform");
+        draw.vertexArray = mesh.vertexArray;
+        draw.indexType = mesh.indexType == GL_UNSIGNED_SHORT ? IndexType::UInt16 : IndexType::UInt32;
+        draw.count = mesh.lods[0].indexCount;
+        draw.first = mesh.lods[0].firstIndex;
+        draw.meshTransform = mesh.positionDecode;
+        draws.push_back(draw);
+        boundsCenter = mesh.boundsCenter;
+        boundsRadius = mesh.boundsRadius;
+    } else {
+        for (DrawItem draw : gltfModel.draws) {
+            draw.program = shaderCache.get(SHADER_INSTANCED | sceneFeatures);
+            draw.transformLocation = glGetUniformLocation(draw.program, "transform");
+            materialSlots.push_back(materials.add(draw.baseColor));
+            draws.push_back(draw);
+        }
+        boundingSphere(gltfModel.boundsMin, gltfModel.boundsMax, boundsCenter, boundsRadius);
+    }
+    materials.upload();
+    for (size_t i = 0; i < materialSlots.size(); ++i) {
+        draws[i].materialBuffer = materials.bufferId();
+        draws[i].materialOffset = materials.offset(materialSlots[i]);
     }
 
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    // Shadow casters: the same draws through depth-only permutations
+    std::vector<DrawItem> shadowDraws;
+    ShadowCascades shadowCascades;
+    ShadowMapsGL shadowMaps;
+    const glm::vec3 sunDirection = glm::normalize(glm::vec3(-0.4f, -0.6f, -1.0f)); // Direction the light travels
+    const glm::vec3 sunColor(0.8f, 0.75f, 0.65f);
+    if (shadowsMode) {
+        uint32_t casterFeatures = SHADER_DEPTH_ONLY | (gltfModel.draws.empty() ?
+            (isQuantized(mesh.vertexFormat) ? SHADER_QUANTIZED : 0) : SHADER_INSTANCED);
+        for (DrawItem draw : draws) {
+            draw.program = shaderCache.get(casterFeatures);
+            draw.transformLocation = glGetUniformLocation(draw.program, "transform");
+            draw.materialBuffer = 0;
+            shadowDraws.push_back(draw);
+        }
+        shadowMaps.init();
+        for (unsigned int program : shaderCache.programsWith(SHADER_SHADOWS))
+            ShadowMapsGL::setSampler(program);
+    }
+    ShaderCache::Stats shaderStats = shaderCache.stats();
+    std::cout << shaderStats.keys << " shader permutations: " << shaderStats.programs << " programs from "
+        << shaderStats.shaders << " compiled stages" << std::endl;
 
   // Enable depth testing to correctly display 3D shapes
     glEnable(GL_DEPTH_TEST);
@@ -199,49 +483,477 @@ int main() {
     const float rotationSpeed = 50.0f;
     bool rotationPending = false;
     float scaleZ = 1.0f; 
-    float lastFrame = 0.0f; 
+    float lastFrame = static_cast<float>(glfwGetTime());
+
+    // Keyboard input: live, recorded, or replayed at fixed simulation ticks
+    InputContext input;
+    InputReplayer replayer;
+    input.recording = !options.recordPath.empty();
+    if (!options.replayPath.empty()) {
+        if (!replayer.load(options.replayPath)) {
+            std::cerr << "Failed to load input recording " << options.replayPath << std::endl;
+            glfwTerminate();
+            return -1;
+        }
+        input.replaying = true;
+    }
+    input.startTime = glfwGetTime();
+    glfwSetWindowUserPointer(window, &input);
+    glfwSetKeyCallback(window, keyCallback);
+    glfwSetWindowRefreshCallback(window, windowRefreshCallback);
+    glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
+    // The framebuffer can differ from the requested 800x600 (high DPI, window managers)
+    glfwGetFramebufferSize(window, &input.framebufferWidth, &input.framebufferHeight);
+    // Recorded, replayed and frame-limited sessions advance time by a fixed
+    // step per tick, so frame N always shows the same scene
+    const bool fixedStep = input.recording || input.replaying || options.frameLimit > 0;
+    const float fixedDeltaTime = 1.0f / 60.0f;
+    FrameTimeLog frameTimes;
+    double lastSwap = glfwGetTime();
+    FramePacer pacer;
+    pacer.setFrameRate(options.fpsCap);
+    FrameQueueLimiter frameQueue;
+    frameQueue.setLimit(options.maxFramesInFlight);
+    FrameTimeLog inputLatency;
+    std::vector<double> seenKeyPressTimes; // Presses the frame being built reacts to
+    // Frames are read back a few frames late and written on another thread,
+    // as image files or as one video stream
+    FrameCapture frameCapture;
+    std::shared_ptr<VideoStream> video;
+    if (!options.videoPath.empty()) {
+        if (!options.capturePrefix.empty())
+            std::cerr << "--capture and --video share the readback, recording the video only" << std::endl;
+        video = std::make_shared<VideoStream>();
+        if (video->open(options.videoPath, options.videoFormat, options.videoFps,
+                static_cast<uint32_t>(options.captureEvery)))
+            frameCapture.init(videoSink(video));
+        else
+            std::cerr << "Failed to open video " << options.videoPath << std::endl;
+    } else if (!options.capturePrefix.empty()) {
+        frameCapture.init(imageFileSink(options.capturePrefix, options.captureFormat));
+    }
+
+    // Scene: instance 0 follows the keyboard, the optional grid spins in place
+    std::vector<PyramidInstance> instances = makePyramidScene(options.gridSize);
+    // Idle mode only pays off when nothing animates by itself; sessions that
+    // count ticks and hidden windows that get no events keep polling
+    const bool animated = std::any_of(instances.begin(), instances.end(),
+        [](const PyramidInstance& instance) { return instance.spinSpeed != 0.0f; });
+    const bool idleMode = options.idle && !fixedStep && !options.headless;
+    if (options.idle && !idleMode)
+        std::cerr << "--idle does not apply to recorded, replayed or headless sessions, ignoring it" << std::endl;
+    // Draws are recorded by the jobs into one command list per chunk and
+    // replayed here, so only GL submission stays on the main thread
+    const size_t recordGrain = 256;
+    std::vector<CommandList> commandLists;
+    std::vector<const CommandList*> recordedLists;
+    GLCommandReplayer commandReplayer;
+    GLCommandReplayer::Stats drawStats;
+    // Shadow casters per cascade, layer (static, dynamic) and record chunk
+    std::vector<CommandList> shadowLists;
+    std::vector<const CommandList*> shadowPass;
+    std::vector<JobTiming> jobTimings;
+    std::vector<glm::mat4> meshletModels;
+    std::vector<std::vector<ProceduralPyramid>> proceduralChunks;
+    int meshletTransformLoc = meshletMode ? glGetUniformLocation(meshletProgram, "transform") : -1;
+    unsigned int statsFrames = 0;
+
+    // Dynamic resolution: the scene renders into an offscreen target sized from
+    // the measured GPU time, then gets upscaled to the window
+    DynamicResolution dynamicResolution(options.dynamicResolutionMs);
+    GpuFrameTimer gpuTimer;
+    ScaledRenderTarget renderTarget;
+    if (dynamicResolution.enabled()) {
+        gpuTimer.init();
+        renderTarget.init(compileProgram(UPSCALE_VERTEX_SHADER_SOURCE, UPSCALE_FRAGMENT_SHADER_SOURCE));
+    }
+
+    // Point lights circle over the scene; the jobs move them to view space and
+    // sort them into clusters every frame
+    std::vector<LightInstance> lightInstances;
+    std::vector<PointLight> viewLights;
+    LightClusters lightClusters;
+    ClusteredLighting lighting;
+    float simulationTime = 0.0f;
+    // Camera, viewport and lighting setup: one upload per frame, shared by every program
+    UniformBlockBuffer<FrameUniforms> frameBlock;
+    UniformBlockBuffer<LightingUniforms> lightingBlock;
+    frameBlock.init(FRAME_BLOCK_BINDING);
+    if (lightingMode) {
+        lightInstances = makeLightScene(options.lightCount, std::max(1.5f, options.gridSize * 0.75f + 0.5f));
+        viewLights.resize(lightInstances.size());
+        lighting.init();
+        lightingBlock.init(LIGHTING_BLOCK_BINDING);
+    }
 
     while (!glfwWindowShouldClose(window)) {
-        //float currentFrame = glfwGetTime();
-        //float deltaTime = currentFrame - lastFrame; 
-        //lastFrame = currentFrame;
-        processInput(window, translation, rotationAngle, rotationPending,scaleZ);
+        // Minimized: nothing to draw into until the window comes back
+        if (input.framebufferWidth == 0 || input.framebufferHeight == 0) {
+            glfwWaitEvents();
+            lastFrame = static_cast<float>(glfwGetTime());
+            continue;
+        }
+
+        // Wait for the GPU queue, and with late input for the frame cap too,
+        // before sampling input so it is as fresh as possible when rendered
+        frameQueue.waitForSlot();
+        if (options.lateInput) {
+            pacer.wait();
+            glfwPollEvents();
+        }
+        float currentFrame = static_cast<float>(glfwGetTime());
+        float deltaTime = fixedStep ? fixedDeltaTime : currentFrame - lastFrame;
+        lastFrame = currentFrame;
+        simulationTime += deltaTime;
+        if (options.frameLimit > 0 && input.tick >= static_cast<uint32_t>(options.frameLimit))
+            break;
+        if (input.replaying) {
+            if (replayer.finished(input.tick))
+                break;
+            replayer.apply(input.tick, input.state, GLFW_PRESS);
+        }
+        processInput(window, input.state, translation, rotationAngle, rotationPending,scaleZ);
+        seenKeyPressTimes.insert(seenKeyPressTimes.end(), input.keyPressTimes.begin(), input.keyPressTimes.end());
+        input.keyPressTimes.clear();
+
+        int viewportWidth = input.framebufferWidth;
+        int viewportHeight = input.framebufferHeight;
+        if (dynamicResolution.enabled()) {
+            float gpuMs, renderedScale;
+            while (gpuTimer.read(gpuMs, renderedScale))
+                dynamicResolution.update(gpuMs, renderedScale);
+            float scale = dynamicResolution.scale();
+            renderTarget.resize(input.framebufferWidth, input.framebufferHeight);
+            renderTarget.bind(scale);
+            gpuTimer.begin(scale);
+            viewportWidth = renderTarget.renderWidth();
+            viewportHeight = renderTarget.renderHeight();
+        } else {
+            glViewport(0, 0, input.framebufferWidth, input.framebufferHeight);
+        }
 
         glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); 
 
-        glUseProgram(shaderProgram);
-
-        // Apply transformations
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, translation); 
-        model = glm::rotate(model, rotationAngle, glm::vec3(0.0f, 0.0f, 1.0f)); 
-        model = glm::scale(model, glm::vec3(1.0f, 1.0f, scaleZ));
-
-        glm::mat4 view = glm::lookAt(
-            glm::vec3(2.0f, 2.0f, 2.0f), 
+        // The camera is fixed, so its view matrix is built once. Kept out of
+        // constant expressions: glm's constexpr lookAt needs C++14 and a
+        // compiler with __builtin_is_constant_evaluated, and this file
+        // should still build without them.
+        static const glm::vec3 cameraPosition(2.0f, 2.0f, 2.0f);
+        static const glm::mat4 view = glm::lookAt(
+            cameraPosition, 
             glm::vec3(0.0f, 0.0f, 0.0f),
             glm::vec3(0.0f, 0.0f, 1.0f)  
         );
 
-        glm::mat4 projection = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 0.1f, 100.0f);
-        glm::mat4 transform = projection * view * model;
-
-        unsigned int transformLoc = glGetUniformLocation(shaderProgram, "transform");
-        glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-
-        glBindVertexArray(VAO);
-        glDrawElements(GL_TRIANGLES, sizeof(indices) / sizeof(indices[0]), GL_UNSIGNED_INT, 0);
-
+        static const float fieldOfView = glm::radians(45.0f);
+        const float aspect = static_cast<float>(input.framebufferWidth) / input.framebufferHeight;
+        glm::mat4 projection = glm::perspective(fieldOfView, aspect, 0.1f, 100.0f);
+        glm::mat4 viewProjection = projection * view;
+        Frustum frustum = extractFrustum(viewProjection);
+
+        // Per-frame CPU work as a job graph: animate -> transforms -> cull -> record.
+        // Jobs only touch instance data and command lists; GL calls stay on this thread.
+        JobGraph frame(jobs);
+        JobGraph::JobId animate = frame.addParallelFor("animate", instances.size(), 256,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    PyramidInstance& instance = instances[i];
+                    if (i == 0) {
+                        instance.position = translation;
+                        instance.rotationAngle = rotationAngle;
+                        instance.scaleZ = scaleZ;
+                    } else {
+                        instance.rotationAngle += instance.spinSpeed * deltaTime;
+                    }
+                }
+            });
+        JobGraph::JobId transforms = frame.addParallelFor("transforms", instances.size(), 256,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    glm::mat4 model = pyramidModelMatrix(instances[i]);
+                    if (shadowsMode && instances[i].spinSpeed == 0.0f && model != instances[i].model) {
+                        // A static caster moved: its old and new cascades redraw their cache
+                        glm::vec3 oldCenter, newCenter;
+                        float oldRadius, newRadius;
+                        instanceWorldBounds(instances[i], boundsCenter, boundsRadius, oldCenter, oldRadius);
+                        instances[i].model = model;
+                        instanceWorldBounds(instances[i], boundsCenter, boundsRadius, newCenter, newRadius);
+                        shadowCascades.invalidate(oldCenter, oldRadius, newCenter, newRadius);
+                    }
+                    instances[i].model = model;
+                    instances[i].transform = viewProjection * instances[i].model;
+                }
+            }, { animate });
+        JobGraph::JobId cull = frame.addParallelFor("cull", instances.size(), 256,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    glm::vec3 center;
+                    float radius;
+                    instanceWorldBounds(instances[i], boundsCenter, boundsRadius, center, radius);
+                    instances[i].visible = sphereInFrustum(frustum, center, radius);
+                }
+            }, { transforms });
+
+        // Apply transformations: one packet per visible pyramid and draw,
+        // sorted by program, vertex array and then front to back
+        commandLists.resize((instances.size() + recordGrain - 1) / recordGrain);
+        if (proceduralMode)
+            proceduralChunks.resize(commandLists.size());
+        frame.addParallelFor("record", instances.size(), recordGrain,
+            [&](size_t begin, size_t end) {
+                CommandList& list = commandLists[begin / recordGrain];
+                list.clear();
+                if (proceduralMode)
+                    proceduralChunks[begin / recordGrain].clear();
+                for (size_t i = begin; i < end; ++i) {
+                    if (!instances[i].visible)
+                        continue;
+                    if (proceduralMode)
+                        proceduralChunks[begin / recordGrain].push_back(makeProceduralPyramid(instances[i]));
+                    float depth = instances[i].transform[3][3] / 100.0f; // View depth over the far plane
+                    for (const DrawItem& draw : draws)
+                        recordDraw(list, draw, instances[i].transform, depth);
+                }
+            }, { cull });
+
+        // Shadow casters: spinning pyramids every frame, static ones only for
+        // cascades whose cache is invalid
+        const size_t recordChunks = commandLists.size();
+        if (shadowsMode) {
+            shadowCascades.update(view, fieldOfView, aspect, 0.1f, sunDirection);
+            shadowLists.resize(SHADOW_CASCADES * 2 * recordChunks);
+            frame.addParallelFor("shadow record", instances.size(), recordGrain,
+                [&](size_t begin, size_t end) {
+                    size_t chunk = begin / recordGrain;
+                    for (int layer = 0; layer < SHADOW_CASCADES * 2; ++layer)
+                        shadowLists[layer * recordChunks + chunk].clear();
+                    for (size_t i = begin; i < end; ++i) {
+                        bool dynamic = instances[i].spinSpeed != 0.0f;
+                        glm::vec3 center;
+                        float radius;
+                        instanceWorldBounds(instances[i], boundsCenter, boundsRadius, center, radius);
+                        for (int c = 0; c < SHADOW_CASCADES; ++c) {
+                            if ((!dynamic && !shadowCascades.staticDirty(c)) ||
+                                !sphereInFrustum(shadowCascades.cascade(c).frustum, center, radius))
+                                continue;
+                            CommandList& list = shadowLists[(c * 2 + (dynamic ? 1 : 0)) * recordChunks + chunk];
+                            glm::mat4 transform = shadowCascades.cascade(c).viewProjection * instances[i].model;
+                            for (const DrawItem& draw : shadowDraws)
+                                recordDraw(list, draw, transform, 0.0f);
+                        }
+                    }
+                }, { transforms });
+        }
+
+        // Lights: view space positions, then one job per depth slice of clusters
+        if (lightingMode) {
+            lightClusters.setProjection(fieldOfView, aspect, 0.1f, 100.0f);
+            lightClusters.begin(viewLights);
+            JobGraph::JobId moveLights = frame.addParallelFor("lights", lightInstances.size(), 1024,
+                [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        glm::vec3 position = lightWorldPosition(lightInstances[i], simulationTime);
+                        viewLights[i].positionRadius = glm::vec4(glm::vec3(view * glm::vec4(position, 1.0f)),
+                            lightInstances[i].radius);
+                        viewLights[i].color = glm::vec4(lightInstances[i].color, 1.0f);
+                    }
+                });
+            frame.addParallelFor("clusters", CLUSTER_SLICES, 1,
+                [&](size_t begin, size_t end) { lightClusters.assignSlices(begin, end); }, { moveLights });
+        }
+        frame.run();
+
+        FrameUniforms frameUniforms;
+        frameUniforms.view = view;
+        frameUniforms.projection = projection;
+        frameUniforms.viewProjection = viewProjection;
+        frameUniforms.inverseProjection = glm::inverse(projection);
+        frameUniforms.viewportTime = glm::vec4(static_cast<float>(viewportWidth), static_cast<float>(viewportHeight),
+            simulationTime, 0.0f);
+        frameBlock.upload(frameUniforms);
+
+        if (lightingMode) {
+            lightClusters.finish();
+            lighting.upload(viewLights, lightClusters);
+            LightingUniforms lightingUniforms = {};
+            ClusteredLighting::writeUniforms(lightingUniforms, lightClusters);
+            if (shadowsMode)
+                ShadowMapsGL::writeUniforms(lightingUniforms, shadowCascades, view, sunDirection, sunColor);
+            lightingBlock.upload(lightingUniforms);
+            lighting.bind();
+        }
+
+        if (shadowsMode) {
+            shadowMaps.begin();
+            for (int c = 0; c < SHADOW_CASCADES; ++c) {
+                bool staticDirty = shadowCascades.staticDirty(c);
+                for (int layer = 0; layer < 2; ++layer) {
+                    // The sampled map is a copy of the cache plus the dynamic casters
+                    if (layer == 0 && !staticDirty)
+                        continue;
+                    if (layer == 1 && !staticDirty && !animated)
+                        continue;
+                    if (layer == 0)
+                        shadowMaps.beginStatic(c);
+                    else
+                        shadowMaps.beginDynamic(c);
+                    shadowPass.clear();
+                    for (size_t chunk = 0; chunk < recordChunks; ++chunk)
+                        shadowPass.push_back(&shadowLists[(c * 2 + layer) * recordChunks + chunk]);
+                    commandReplayer.replay(shadowPass, false);
+                }
+            }
+            shadowCascades.staticDrawn();
+            shadowMaps.end();
+            shadowMaps.bindForSampling();
+        }
+
+        recordedLists.clear();
+        for (const CommandList& list : commandLists)
+            recordedLists.push_back(&list);
+        drawStats = commandReplayer.replay(recordedLists);
+
+        // Procedural mode: visible instances packed per chunk, one instanced draw
+        if (proceduralMode) {
+            proceduralRenderer.upload(proceduralChunks);
+            proceduralRenderer.draw();
+        }
+
+        // Meshlet mode: the CPU culls whole instances, the GPU their meshlets
+        if (meshletMode) {
+            meshletModels.clear();
+            for (const PyramidInstance& instance : instances) {
+                if (instance.visible)
+                    meshletModels.push_back(instance.model * mesh.positionDecode);
+            }
+            meshletCuller.cull(meshletModels, frustum, cameraPosition);
+            glUseProgram(meshletProgram);
+            glUniformMatrix4fv(meshletTransformLoc, 1, GL_FALSE, glm::value_ptr(viewProjection));
+            materials.bind(0);
+            meshletCuller.draw();
+        }
+
+        if (dynamicResolution.enabled()) {
+            renderTarget.upscale(options.sharpness);
+            gpuTimer.end();
+        }
+
+        if (frameCapture.enabled()) {
+            frameCapture.poll();
+            // The Nth frame rendered is the first one captured, so --frames N
+            // --capture-every N captures exactly the last frame
+            if ((input.tick + 1) % options.captureEvery == 0)
+                frameCapture.capture(input.framebufferWidth, input.framebufferHeight, input.tick);
+        }
+
+        // Job timings are recorded every frame; report the averages on request
+        std::vector<JobTiming> frameTimings = jobs.takeTimings();
+        if (options.printJobStats) {
+            jobTimings.insert(jobTimings.end(), frameTimings.begin(), frameTimings.end());
+            if (++statsFrames == 120) {
+                std::cout << "Jobs (avg ms/frame, " << jobs.workerCount() << " workers, "
+                    << drawStats.draws << " draws, " << instances.size() << " instances";
+                if (meshletMode)
+                    std::cout << ", " << meshletCuller.readDrawCount() << "/"
+                        << meshletModels.size() * meshletCuller.meshletsPerInstance() << " meshlets";
+                if (proceduralMode)
+                    std::cout << ", " << proceduralRenderer.drawnCount() << " procedural";
+                if (lightingMode)
+                    std::cout << ", " << lightInstances.size() << " lights, "
+                        << static_cast<float>(lightClusters.lightIndexCount()) / CLUSTER_COUNT << " per cluster";
+                if (dynamicResolution.enabled())
+                    std::cout << ", render " << renderTarget.renderWidth() << "x" << renderTarget.renderHeight()
+                        << " at " << dynamicResolution.predictedGpuMs() << " ms GPU";
+                std::cout << "):";
+                for (const auto& entry : summarizeJobTimings(jobTimings, statsFrames))
+                    std::cout << " " << entry.first << "=" << entry.second;
+                std::cout << std::endl;
+                jobTimings.clear();
+                statsFrames = 0;
+            }
+        }
+
+        if (!options.lateInput)
+            pacer.wait();
         glfwSwapBuffers(window);
-        glfwPollEvents();
+        double swapTime = glfwGetTime();
+        frameQueue.frameSubmitted();
+        frameTimes.add((swapTime - lastSwap) * 1000.0);
+        lastSwap = swapTime;
+        for (double pressTime : seenKeyPressTimes)
+            inputLatency.add((swapTime - pressTime) * 1000.0);
+        seenKeyPressTimes.clear();
+
+        // Events polled now are seen by the next simulation tick
+        ++input.tick;
+        input.redraw = false;
+        if (!options.lateInput)
+            glfwPollEvents();
+
+        // Idle: a still scene with no key held looks the same next frame, so
+        // block until an event changes that. The timeout only bounds how long
+        // a missed wakeup could stall the loop.
+        if (idleMode && !animated && !input.redraw && !input.state.anyDown()) {
+            while (!input.redraw && !glfwWindowShouldClose(window))
+                glfwWaitEventsTimeout(0.5);
+            // The time spent waiting is not simulated or counted as a frame
+            lastFrame = static_cast<float>(glfwGetTime());
+            lastSwap = glfwGetTime();
+            pacer.reset();
+        }
+    }
+
+    if (input.recording) {
+        if (input.recorder.save(options.recordPath, input.tick))
+            std::cout << "Recorded " << input.recorder.eventCount() << " key events over " << input.tick
+                << " ticks to " << options.recordPath << std::endl;
+        else
+            std::cerr << "Failed to write input recording " << options.recordPath << std::endl;
+    }
+    if (input.replaying)
+        frameTimes.printSummary(std::cout, "Replay " + options.replayPath);
+    if (!options.frameTimesPath.empty() && !frameTimes.writeCsv(options.frameTimesPath))
+        std::cerr << "Failed to write frame times " << options.frameTimesPath << std::endl;
+    if (!options.latencyLogPath.empty()) {
+        inputLatency.printSummary(std::cout, "Key press to swap", "presses");
+        if (!inputLatency.writeCsv(options.latencyLogPath, "press"))
+            std::cerr << "Failed to write input latency " << options.latencyLogPath << std::endl;
     }
     
     // Cleanup and terminate
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
-    glDeleteBuffers(1, &EBO);
-    glDeleteProgram(shaderProgram);
+    destroyMesh(mesh);
+    destroyGltf(gltfModel);
+    shaderCache.destroy();
+    materials.destroy();
+    frameBlock.destroy();
+    if (meshletMode)
+        meshletCuller.destroy();
+    if (proceduralMode)
+        proceduralRenderer.destroy();
+    if (dynamicResolution.enabled()) {
+        gpuTimer.destroy();
+        renderTarget.destroy();
+    }
+    frameQueue.destroy();
+    if (frameCapture.enabled()) {
+        frameCapture.destroy();
+        std::cout << "Captured " << frameCapture.writtenCount() << " frames to "
+            << (video ? options.videoPath : options.capturePrefix) << " (" << frameCapture.droppedCount()
+            << " dropped, " << frameCapture.failedCount() << " failed to write";
+        if (video)
+            std::cout << ", " << video->skippedCount() << " skipped after a resize, " << video->repeatedCount()
+                << " repeated to keep " << options.videoFps << " fps, " << video->frameWidth() << "x"
+                << video->frameHeight();
+        std::cout << ")" << std::endl;
+    }
+    if (lightingMode) {
+        lighting.destroy();
+        lightingBlock.destroy();
+    }
+    if (shadowsMode) {
+        shadowMaps.destroy();
+    }
 
     glfwTerminate();
     return 0;
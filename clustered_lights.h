@@ -0,0 +1,212 @@
+#pragma once
+
+// Clustered forward lighting, CPU side. The view frustum is cut into
+// 16 x 9 screen tiles and 24 depth slices (exponential in view depth, so
+// clusters stay roughly cube shaped). Every frame each point light is
+// assigned to the clusters its sphere touches, and every cluster gets a
+// compact range in one shared light index list. The fragment shader finds
+// its cluster from gl_FragCoord and its depth and loops over that range
+// only, so shading cost follows the number of lights nearby, not the total.
+//
+// Slices are assigned independently (one job per slice); finish() then
+// turns the per-slice ranges into offsets in the concatenated list.
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+const uint32_t CLUSTER_TILES_X = 16;
+const uint32_t CLUSTER_TILES_Y = 9;
+const uint32_t CLUSTER_SLICES = 24;
+const uint32_t CLUSTER_COUNT = CLUSTER_TILES_X * CLUSTER_TILES_Y * CLUSTER_SLICES;
+
+// Same layout as the std430 struct in the lighting shader
+struct PointLight {
+    glm::vec4 positionRadius; // View space position, radius where the light fades to zero
+    glm::vec4 color;          // rgb, w unused
+};
+static_assert(sizeof(PointLight) == 32, "PointLight must match the GPU layout");
+
+struct ClusterRange {
+    uint32_t offset; // Into the light index list
+    uint32_t count;
+};
+
+// A light circling a point above the ground plane
+struct LightInstance {
+    glm::vec3 orbitCenter;
+    float orbitRadius;
+    float phase;
+    float speed;  // Radians per second
+    float radius;
+    glm::vec3 color;
+};
+
+inline glm::vec3 lightWorldPosition(const LightInstance& light, float time) {
+    float angle = light.phase + light.speed * time;
+    return light.orbitCenter + glm::vec3(std::cos(angle), std::sin(angle), 0.0f) * light.orbitRadius;
+}
+
+// `count` lights spread over a square of the given half extent, same seed every run
+inline std::vector<LightInstance> makeLightScene(size_t count, float halfExtent) {
+    std::mt19937 random(371);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<LightInstance> lights(count);
+    for (LightInstance& light : lights) {
+        light.orbitCenter = glm::vec3((unit(random) * 2.0f - 1.0f) * halfExtent,
+            (unit(random) * 2.0f - 1.0f) * halfExtent, 0.2f + unit(random));
+        light.orbitRadius = 0.2f + 0.6f * unit(random);
+        light.phase = unit(random) * 6.2831853f;
+        light.speed = (unit(random) - 0.5f) * 2.0f;
+        light.radius = 0.5f + unit(random);
+        // Saturated hue: one channel full, one off, one in between
+        glm::vec3 hue(1.0f, unit(random), 0.0f);
+        int rotation = static_cast<int>(unit(random) * 3.0f) % 3;
+        light.color = glm::vec3(hue[rotation], hue[(rotation + 1) % 3], hue[(rotation + 2) % 3]);
+    }
+    return lights;
+}
+
+class LightClusters {
+public:
+    // Cluster bounds depend only on the projection; recomputed when it changes
+    void setProjection(float fovY, float aspect, float nearZ, float farZ) {
+        if (fovY == projection[0] && aspect == projection[1] && nearZ == projection[2] && farZ == projection[3])
+            return;
+        projection[0] = fovY;
+        projection[1] = aspect;
+        projection[2] = nearZ;
+        projection[3] = farZ;
+        tanY = std::tan(fovY * 0.5f);
+        tanX = tanY * aspect;
+        nearDepth = nearZ;
+        logDepthRatio = std::log(farZ / nearZ);
+        boundsMin.resize(CLUSTER_COUNT);
+        boundsMax.resize(CLUSTER_COUNT);
+        for (uint32_t z = 0; z < CLUSTER_SLICES; ++z) {
+            float depths[2] = { sliceDepth(z), sliceDepth(z + 1) };
+            for (uint32_t y = 0; y < CLUSTER_TILES_Y; ++y) {
+                for (uint32_t x = 0; x < CLUSTER_TILES_X; ++x) {
+                    // View space looks down -z; the tile's corner rays at both depths
+                    glm::vec3 lo(1e30f), hi(-1e30f);
+                    for (float depth : depths) {
+                        for (uint32_t cx = x; cx <= x + 1; ++cx) {
+                            for (uint32_t cy = y; cy <= y + 1; ++cy) {
+                                glm::vec3 corner((cx * 2.0f / CLUSTER_TILES_X - 1.0f) * tanX * depth,
+                                    (cy * 2.0f / CLUSTER_TILES_Y - 1.0f) * tanY * depth, -depth);
+                                lo = glm::min(lo, corner);
+                                hi = glm::max(hi, corner);
+                            }
+                        }
+                    }
+                    boundsMin[clusterIndex(x, y, z)] = lo;
+                    boundsMax[clusterIndex(x, y, z)] = hi;
+                }
+            }
+        }
+    }
+
+    // Slice = log(depth) * scale + bias, as used by the shader
+    float sliceScale() const { return CLUSTER_SLICES / logDepthRatio; }
+    float sliceBias() const { return -std::log(nearDepth) * sliceScale(); }
+
+    static uint32_t clusterIndex(uint32_t x, uint32_t y, uint32_t z) {
+        return (z * CLUSTER_TILES_Y + y) * CLUSTER_TILES_X + x;
+    }
+
+    // Start a frame with the lights already in view space
+    void begin(const std::vector<PointLight>& viewSpaceLights) {
+        lights = &viewSpaceLights;
+        ranges.resize(CLUSTER_COUNT);
+        sliceIndices.resize(CLUSTER_SLICES);
+    }
+
+    // Fill slices [begin, end); different slices may run on different threads
+    void assignSlices(size_t begin, size_t end) {
+        std::vector<std::vector<uint32_t>> clusterLights(CLUSTER_TILES_X * CLUSTER_TILES_Y);
+        for (size_t z = begin; z < end; ++z) {
+            for (auto& list : clusterLights)
+                list.clear();
+            float sliceNear = sliceDepth(static_cast<uint32_t>(z));
+            float sliceFar = sliceDepth(static_cast<uint32_t>(z) + 1);
+            for (uint32_t i = 0; i < lights->size(); ++i) {
+                glm::vec3 center((*lights)[i].positionRadius);
+                float radius = (*lights)[i].positionRadius.w;
+                float nearest = std::max(-center.z - radius, sliceNear);
+                float farthest = std::min(-center.z + radius, sliceFar);
+                if (nearest > farthest)
+                    continue;
+                // Screen extent of the sphere's box within this slice
+                uint32_t x0, x1, y0, y1;
+                tileRange(center.x, radius, nearest, farthest, tanX, CLUSTER_TILES_X, x0, x1);
+                tileRange(center.y, radius, nearest, farthest, tanY, CLUSTER_TILES_Y, y0, y1);
+                for (uint32_t y = y0; y <= y1; ++y) {
+                    for (uint32_t x = x0; x <= x1; ++x) {
+                        uint32_t cluster = clusterIndex(x, y, static_cast<uint32_t>(z));
+                        glm::vec3 closest = glm::clamp(center, boundsMin[cluster], boundsMax[cluster]);
+                        glm::vec3 offset = closest - center;
+                        if (glm::dot(offset, offset) <= radius * radius)
+                            clusterLights[y * CLUSTER_TILES_X + x].push_back(i);
+                    }
+                }
+            }
+            std::vector<uint32_t>& indices = sliceIndices[z];
+            indices.clear();
+            for (uint32_t tile = 0; tile < clusterLights.size(); ++tile) {
+                ClusterRange& range = ranges[z * CLUSTER_TILES_X * CLUSTER_TILES_Y + tile];
+                range.offset = static_cast<uint32_t>(indices.size());
+                range.count = static_cast<uint32_t>(clusterLights[tile].size());
+                indices.insert(indices.end(), clusterLights[tile].begin(), clusterLights[tile].end());
+            }
+        }
+    }
+
+    // After every slice is assigned: make the offsets global
+    void finish() {
+        uint32_t base = 0;
+        for (uint32_t z = 0; z < CLUSTER_SLICES; ++z) {
+            for (uint32_t tile = 0; tile < CLUSTER_TILES_X * CLUSTER_TILES_Y; ++tile)
+                ranges[z * CLUSTER_TILES_X * CLUSTER_TILES_Y + tile].offset += base;
+            base += static_cast<uint32_t>(sliceIndices[z].size());
+        }
+        totalIndices = base;
+    }
+
+    const std::vector<ClusterRange>& clusterRanges() const { return ranges; }
+    // The light index list, one piece per slice in order
+    const std::vector<std::vector<uint32_t>>& lightIndices() const { return sliceIndices; }
+    uint32_t lightIndexCount() const { return totalIndices; }
+
+private:
+    float sliceDepth(uint32_t slice) const {
+        return nearDepth * std::exp(logDepthRatio * slice / CLUSTER_SLICES);
+    }
+
+    // Tiles covered by [c - r, c + r] seen from depths [nearest, farthest]
+    static void tileRange(float c, float r, float nearest, float farthest, float tanHalf, uint32_t tiles,
+        uint32_t& first, uint32_t& last) {
+        float lo = std::min((c - r) / nearest, (c - r) / farthest) / tanHalf;
+        float hi = std::max((c + r) / nearest, (c + r) / farthest) / tanHalf;
+        auto tile = [tiles](float ndc) {
+            float t = std::floor((ndc * 0.5f + 0.5f) * tiles);
+            return static_cast<uint32_t>(std::min(std::max(t, 0.0f), static_cast<float>(tiles - 1)));
+        };
+        first = tile(lo);
+        last = tile(hi);
+    }
+
+    float projection[4] = {};
+    float tanX = 1.0f;
+    float tanY = 1.0f;
+    float nearDepth = 0.1f;
+    float logDepthRatio = 1.0f;
+    std::vector<glm::vec3> boundsMin;
+    std::vector<glm::vec3> boundsMax;
+    const std::vector<PointLight>* lights = nullptr;
+    std::vector<ClusterRange> ranges;
+    std::vector<std::vector<uint32_t>> sliceIndices;
+    uint32_t totalIndices = 0;
+};
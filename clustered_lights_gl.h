@@ -0,0 +1,78 @@
+#pragma once
+
+// GL side of clustered lighting: the three storage buffers the LIGHTING
+// permutation of the scene fragment shader (scene_shaders.h) reads: lights,
+// per-cluster ranges and light indices. Needs OpenGL 4.3 for shader storage
+// buffers. Bindings 4-6 keep clear of the buffers the meshlet and procedural
+// passes bind.
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include "clustered_lights.h"
+#include "gl_resources.h"
+#include "uniform_blocks.h"
+
+class ClusteredLighting {
+public:
+    static bool isSupported() {
+        return GLEW_VERSION_4_3 != 0;
+    }
+
+    void init() {
+        GLint alignment = 256;
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        lightBuffer.init(static_cast<size_t>(alignment));
+        clusterBuffer.init(static_cast<size_t>(alignment));
+        indexBuffer.init(static_cast<size_t>(alignment));
+    }
+
+    // Write this frame's lights and cluster lists into the next slice of
+    // each stream buffer; earlier frames' slices stay untouched
+    void upload(const std::vector<PointLight>& lights, const LightClusters& clusters) {
+        lightBuffer.begin(lights.size() * sizeof(PointLight));
+        lightBuffer.write(0, lights.data(), lights.size() * sizeof(PointLight));
+        clusterBuffer.begin(clusters.clusterRanges().size() * sizeof(ClusterRange));
+        clusterBuffer.write(0, clusters.clusterRanges().data(), clusters.clusterRanges().size() * sizeof(ClusterRange));
+        indexBuffer.begin(clusters.lightIndexCount() * sizeof(uint32_t));
+        size_t offset = 0;
+        for (const std::vector<uint32_t>& slice : clusters.lightIndices()) {
+            size_t bytes = slice.size() * sizeof(uint32_t);
+            indexBuffer.write(offset, slice.data(), bytes);
+            offset += bytes;
+        }
+    }
+
+    // This frame's cluster parameters in the Lighting block; the viewport
+    // and inverse projection come from the Frame block
+    static void writeUniforms(LightingUniforms& uniforms, const LightClusters& clusters) {
+        uniforms.clusterCount = glm::uvec4(CLUSTER_TILES_X, CLUSTER_TILES_Y, CLUSTER_SLICES, 0);
+        uniforms.sliceScaleBias = glm::vec4(clusters.sliceScale(), clusters.sliceBias(), 0.0f, 0.0f);
+        uniforms.ambient = glm::vec4(0.15f, 0.15f, 0.15f, 0.0f);
+    }
+
+    // Bind this frame's slices before drawing; other passes may have reused
+    // the binding points
+    void bind() const {
+        bindSlice(4, lightBuffer);
+        bindSlice(5, clusterBuffer);
+        bindSlice(6, indexBuffer);
+    }
+
+    void destroy() {
+        lightBuffer.destroy();
+        clusterBuffer.destroy();
+        indexBuffer.destroy();
+        *this = ClusteredLighting();
+    }
+
+private:
+    static void bindSlice(GLuint binding, const StreamBuffer& buffer) {
+        glBindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, buffer.id(), static_cast<GLintptr>(buffer.offset()),
+            static_cast<GLsizeiptr>(buffer.size()));
+    }
+
+    StreamBuffer lightBuffer;
+    StreamBuffer clusterBuffer;
+    StreamBuffer indexBuffer;
+};
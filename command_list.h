@@ -0,0 +1,183 @@
+#pragma once
+
+// Backend-neutral command lists. Any thread can record binds, uniform/buffer
+// updates and draws into its own CommandList without touching the GL
+// context; the render thread replays the lists afterwards (see
+// command_replay_gl.h). Commands are grouped into packets that carry a sort
+// key, so lists recorded by different workers can be merged into one
+// state-friendly order while equal keys keep their submission order.
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+enum class CommandType : uint32_t {
+    BindProgram,
+    BindVertexArray,
+    BindUniformBuffer,
+    UpdateBuffer,
+    SetUniformMat4,
+    SetUniformVec4,
+    DrawIndexed,
+    DrawArrays
+};
+
+enum class PrimitiveType : uint32_t { Triangles, Lines, Points, TriangleStrip, TriangleFan, LineStrip, LineLoop };
+enum class IndexType : uint32_t { UInt16, UInt32, UInt8 };
+
+inline uint32_t indexSize(IndexType type) {
+    return type == IndexType::UInt8 ? 1 : type == IndexType::UInt16 ? 2 : 4;
+}
+
+struct CommandHeader {
+    CommandType type;
+    uint32_t size; // Payload bytes that follow the header
+};
+
+struct BindProgramCommand { uint32_t program; };
+struct BindVertexArrayCommand { uint32_t vertexArray; };
+struct BindUniformBufferCommand { uint32_t binding; uint32_t buffer; uint32_t offset; uint32_t size; };
+struct UpdateBufferCommand { uint32_t buffer; uint32_t offset; uint32_t size; }; // followed by `size` bytes
+struct SetUniformMat4Command { int32_t location; float value[16]; };
+struct SetUniformVec4Command { int32_t location; float value[4]; };
+struct DrawIndexedCommand {
+    PrimitiveType primitive;
+    IndexType indexType;
+    uint32_t indexCount;
+    uint32_t firstIndex;
+    uint32_t instanceCount;
+    int32_t baseVertex;
+};
+struct DrawArraysCommand { PrimitiveType primitive; uint32_t first; uint32_t count; uint32_t instanceCount; };
+
+// 64-bit sort key: layer (8 bits) | program (16) | vertex array (16) | depth (24).
+// Lower keys replay first, so opaque geometry is drawn front to back per state.
+inline uint64_t makeSortKey(uint32_t layer, uint32_t program, uint32_t vertexArray, float depth01) {
+    float clamped = std::min(std::max(depth01, 0.0f), 1.0f);
+    uint64_t depthBits = static_cast<uint64_t>(clamped * 16777215.0f);
+    return (static_cast<uint64_t>(layer & 0xFF) << 56) | (static_cast<uint64_t>(program & 0xFFFF) << 40) |
+        (static_cast<uint64_t>(vertexArray & 0xFFFF) << 24) | depthBits;
+}
+
+class CommandList {
+public:
+    struct Packet {
+        uint64_t sortKey;
+        uint32_t begin; // Byte range of the packet in the command stream
+        uint32_t end;
+    };
+
+    void clear() {
+        commands.clear();
+        packets.clear();
+    }
+
+    // Start a new packet; commands recorded until the next call belong to it
+    void beginPacket(uint64_t sortKey) {
+        closePacket();
+        packets.push_back({ sortKey, static_cast<uint32_t>(commands.size()), static_cast<uint32_t>(commands.size()) });
+    }
+
+    void bindProgram(uint32_t program) { write(CommandType::BindProgram, BindProgramCommand{ program }); }
+    void bindVertexArray(uint32_t vertexArray) { write(CommandType::BindVertexArray, BindVertexArrayCommand{ vertexArray }); }
+
+    void bindUniformBuffer(uint32_t binding, uint32_t buffer, uint32_t offset, uint32_t size) {
+        write(CommandType::BindUniformBuffer, BindUniformBufferCommand{ binding, buffer, offset, size });
+    }
+
+    // The data is copied into the list, the caller's memory can be reused at once
+    void updateBuffer(uint32_t buffer, uint32_t offset, const void* data, uint32_t size) {
+        UpdateBufferCommand command{ buffer, offset, size };
+        writeHeader(CommandType::UpdateBuffer, static_cast<uint32_t>(sizeof(command) + alignedSize(size)));
+        append(&command, sizeof(command));
+        append(data, size);
+        commands.resize(commands.size() + (alignedSize(size) - size), 0);
+        closePacket();
+    }
+
+    void setUniform(int32_t location, const glm::mat4& value) {
+        SetUniformMat4Command command;
+        command.location = location;
+        std::memcpy(command.value, &value[0][0], sizeof(command.value));
+        write(CommandType::SetUniformMat4, command);
+    }
+
+    void setUniform(int32_t location, const glm::vec4& value) {
+        SetUniformVec4Command command;
+        command.location = location;
+        std::memcpy(command.value, &value[0], sizeof(command.value));
+        write(CommandType::SetUniformVec4, command);
+    }
+
+    void drawIndexed(PrimitiveType primitive, IndexType indexType, uint32_t indexCount,
+        uint32_t firstIndex = 0, uint32_t instanceCount = 1, int32_t baseVertex = 0) {
+        write(CommandType::DrawIndexed,
+            DrawIndexedCommand{ primitive, indexType, indexCount, firstIndex, instanceCount, baseVertex });
+    }
+
+    void drawArrays(PrimitiveType primitive, uint32_t first, uint32_t count, uint32_t instanceCount = 1) {
+        write(CommandType::DrawArrays, DrawArraysCommand{ primitive, first, count, instanceCount });
+    }
+
+    const std::vector<uint8_t>& stream() const { return commands; }
+    const std::vector<Packet>& packetList() const { return packets; }
+    bool empty() const { return packets.empty(); }
+
+private:
+    static uint32_t alignedSize(uint32_t size) { return (size + 3u) & ~3u; }
+
+    template <typename T>
+    void write(CommandType type, const T& command) {
+        writeHeader(type, sizeof(T));
+        append(&command, sizeof(T));
+        closePacket();
+    }
+
+    void writeHeader(CommandType type, uint32_t size) {
+        // Commands recorded before the first beginPacket() get a packet with key 0
+        if (packets.empty())
+            beginPacket(0);
+        CommandHeader header{ type, size };
+        append(&header, sizeof(header));
+    }
+
+    void append(const void* data, size_t size) {
+        size_t offset = commands.size();
+        commands.resize(offset + size);
+        if (size > 0)
+            std::memcpy(commands.data() + offset, data, size);
+    }
+
+    void closePacket() {
+        if (!packets.empty())
+            packets.back().end = static_cast<uint32_t>(commands.size());
+    }
+
+    std::vector<uint8_t> commands;
+    std::vector<Packet> packets;
+};
+
+// A packet of one list, ordered by sort key and then by submission order
+struct CommandPacketRef {
+    uint64_t sortKey;
+    uint32_t list;
+    uint32_t packet;
+};
+
+// Merge the packets of lists[0..n) into replay order. Lists are taken in
+// submission order; sorting is stable, so equal keys keep that order.
+inline void mergeCommandLists(const std::vector<const CommandList*>& lists, bool sortByKey,
+    std::vector<CommandPacketRef>& order) {
+    order.clear();
+    for (uint32_t l = 0; l < lists.size(); ++l) {
+        const std::vector<CommandList::Packet>& packets = lists[l]->packetList();
+        for (uint32_t p = 0; p < packets.size(); ++p)
+            order.push_back({ packets[p].sortKey, l, p });
+    }
+    if (sortByKey) {
+        std::stable_sort(order.begin(), order.end(),
+            [](const CommandPacketRef& a, const CommandPacketRef& b) { return a.sortKey < b.sortKey; });
+    }
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+// OpenGL backend for command_list.h. Only the thread that owns the context
+// may call replay(); it walks the merged packets once and skips program,
+// vertex array and uniform buffer binds that would not change any state.
+
+#include <GL/glew.h>
+#include <cstring>
+#include <vector>
+#include "command_list.h"
+#include "gl_resources.h"
+
+class GLCommandReplayer {
+public:
+    struct Stats {
+        unsigned int packets = 0;
+        unsigned int draws = 0;
+        unsigned int skippedBinds = 0;
+    };
+
+    // Replay lists in submission order, merged by sort key when sortByKey is set
+    Stats replay(const std::vector<const CommandList*>& lists, bool sortByKey = true) {
+        Stats stats;
+        mergeCommandLists(lists, sortByKey, order);
+        currentProgram = ~0u;
+        currentVertexArray = ~0u;
+        for (BindUniformBufferCommand& range : currentUniformBuffers)
+            range = BindUniformBufferCommand{ ~0u, 0, 0, 0 };
+        for (const CommandPacketRef& ref : order) {
+            const CommandList& list = *lists[ref.list];
+            const CommandList::Packet& packet = list.packetList()[ref.packet];
+            executePacket(list.stream().data() + packet.begin, list.stream().data() + packet.end, stats);
+            ++stats.packets;
+        }
+        return stats;
+    }
+
+private:
+    static GLenum toGL(PrimitiveType primitive) {
+        switch (primitive) {
+        case PrimitiveType::Lines: return GL_LINES;
+        case PrimitiveType::Points: return GL_POINTS;
+        case PrimitiveType::TriangleStrip: return GL_TRIANGLE_STRIP;
+        case PrimitiveType::TriangleFan: return GL_TRIANGLE_FAN;
+        case PrimitiveType::LineStrip: return GL_LINE_STRIP;
+        case PrimitiveType::LineLoop: return GL_LINE_LOOP;
+        default: return GL_TRIANGLES;
+        }
+    }
+
+    static GLenum toGL(IndexType type) {
+        switch (type) {
+        case IndexType::UInt8: return GL_UNSIGNED_BYTE;
+        case IndexType::UInt16: return GL_UNSIGNED_SHORT;
+        default: return GL_UNSIGNED_INT;
+        }
+    }
+
+    template <typename T>
+    static T read(const uint8_t* data) {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return value;
+    }
+
+    void executePacket(const uint8_t* cursor, const uint8_t* end, Stats& stats) {
+        while (cursor < end) {
+            CommandHeader header = read<CommandHeader>(cursor);
+            const uint8_t* payload = cursor + sizeof(CommandHeader);
+            switch (header.type) {
+            case CommandType::BindProgram: {
+                BindProgramCommand command = read<BindProgramCommand>(payload);
+                if (command.program != currentProgram) {
+                    glUseProgram(command.program);
+                    currentProgram = command.program;
+                } else {
+                    ++stats.skippedBinds;
+                }
+                break;
+            }
+            case CommandType::BindVertexArray: {
+                BindVertexArrayCommand command = read<BindVertexArrayCommand>(payload);
+                if (command.vertexArray != currentVertexArray) {
+                    glBindVertexArray(command.vertexArray);
+                    currentVertexArray = command.vertexArray;
+                } else {
+                    ++stats.skippedBinds;
+                }
+                break;
+            }
+            case CommandType::BindUniformBuffer: {
+                BindUniformBufferCommand command = read<BindUniformBufferCommand>(payload);
+                if (command.binding < UNIFORM_BUFFER_CACHE) {
+                    BindUniformBufferCommand& current = currentUniformBuffers[command.binding];
+                    if (std::memcmp(&current, &command, sizeof(command)) == 0) {
+                        ++stats.skippedBinds;
+                        break;
+                    }
+                    current = command;
+                }
+                if (command.size > 0)
+                    glBindBufferRange(GL_UNIFORM_BUFFER, command.binding, command.buffer, command.offset, command.size);
+                else
+                    glBindBufferBase(GL_UNIFORM_BUFFER, command.binding, command.buffer);
+                break;
+            }
+            case CommandType::UpdateBuffer: {
+                UpdateBufferCommand command = read<UpdateBufferCommand>(payload);
+                writeBuffer(command.buffer, command.offset, command.size, payload + sizeof(command));
+                break;
+            }
+            case CommandType::SetUniformMat4: {
+                SetUniformMat4Command command = read<SetUniformMat4Command>(payload);
+                glUniformMatrix4fv(command.location, 1, GL_FALSE, command.value);
+                break;
+            }
+            case CommandType::SetUniformVec4: {
+                SetUniformVec4Command command = read<SetUniformVec4Command>(payload);
+                glUniform4fv(command.location, 1, command.value);
+                break;
+            }
+            case CommandType::DrawIndexed: {
+                DrawIndexedCommand command = read<DrawIndexedCommand>(payload);
+                GLenum indexType = toGL(command.indexType);
+                const void* offset = reinterpret_cast<const void*>(
+                    static_cast<size_t>(command.firstIndex) * indexSize(command.indexType));
+                if (command.instanceCount == 1 && command.baseVertex == 0)
+                    glDrawElements(toGL(command.primitive), command.indexCount, indexType, offset);
+                else
+                    glDrawElementsInstancedBaseVertex(toGL(command.primitive), command.indexCount, indexType,
+                        offset, command.instanceCount, command.baseVertex);
+                ++stats.draws;
+                break;
+            }
+            case CommandType::DrawArrays: {
+                DrawArraysCommand command = read<DrawArraysCommand>(payload);
+                if (command.instanceCount == 1)
+                    glDrawArrays(toGL(command.primitive), command.first, command.count);
+                else
+                    glDrawArraysInstanced(toGL(command.primitive), command.first, command.count, command.instanceCount);
+                ++stats.draws;
+                break;
+            }
+            }
+            cursor = payload + header.size;
+        }
+    }
+
+    // Binding points below this get redundant binds skipped
+    static const uint32_t UNIFORM_BUFFER_CACHE = 8;
+
+    std::vector<CommandPacketRef> order;
+    BindUniformBufferCommand currentUniformBuffers[UNIFORM_BUFFER_CACHE] = {};
+    GLuint currentProgram = ~0u;
+    GLuint currentVertexArray = ~0u;
+};
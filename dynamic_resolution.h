@@ -0,0 +1,55 @@
+#pragma once
+
+// Render scale controller for dynamic resolution. GPU time grows with the
+// pixel count, i.e. with the square of the scale, so every measurement is
+// turned into a cost per unit of area using the scale that frame was rendered
+// at. Timer results arrive a few frames late; tying them to their own scale
+// keeps the estimate right while the scale changes. The scale moves a small
+// step per frame towards the one the smoothed cost predicts, and holds still
+// while the predicted time sits in a band just below the target.
+
+#include <algorithm>
+#include <cmath>
+
+const float DYNAMIC_RESOLUTION_MIN_SCALE = 0.5f;
+const float DYNAMIC_RESOLUTION_STEPS = 32.0f;     // Render sizes snap to 1/32 of the window
+const float DYNAMIC_RESOLUTION_MAX_STEP = 0.05f;  // Largest scale change per frame
+const float DYNAMIC_RESOLUTION_HEADROOM = 0.85f;  // Grow only below this fraction of the target
+
+class DynamicResolution {
+public:
+    explicit DynamicResolution(float targetMilliseconds = 0.0f) : targetMs(targetMilliseconds) {}
+
+    bool enabled() const { return targetMs > 0.0f; }
+
+    // Feed one measured GPU frame time and the scale that frame used
+    void update(float gpuMilliseconds, float renderedScale) {
+        if (!enabled() || gpuMilliseconds <= 0.0f || renderedScale <= 0.0f)
+            return;
+        float cost = gpuMilliseconds / (renderedScale * renderedScale);
+        areaCost = areaCost > 0.0f ? areaCost + (cost - areaCost) * 0.2f : cost;
+        float predicted = areaCost * currentScale * currentScale;
+        if (predicted <= targetMs && predicted >= targetMs * DYNAMIC_RESOLUTION_HEADROOM)
+            return;
+        // Aim for the middle of the band
+        float goal = targetMs * (1.0f + DYNAMIC_RESOLUTION_HEADROOM) * 0.5f;
+        float desired = std::sqrt(goal / areaCost);
+        float step = std::min(std::max(desired - currentScale, -DYNAMIC_RESOLUTION_MAX_STEP),
+            DYNAMIC_RESOLUTION_MAX_STEP);
+        currentScale = std::min(std::max(currentScale + step, DYNAMIC_RESOLUTION_MIN_SCALE), 1.0f);
+    }
+
+    // Scale the next frame renders at, snapped so small changes do not resize every frame
+    float scale() const {
+        return std::max(std::round(currentScale * DYNAMIC_RESOLUTION_STEPS) / DYNAMIC_RESOLUTION_STEPS,
+            DYNAMIC_RESOLUTION_MIN_SCALE);
+    }
+
+    // GPU time the current scale is expected to take
+    float predictedGpuMs() const { return areaCost * currentScale * currentScale; }
+
+private:
+    float targetMs;
+    float currentScale = 1.0f;
+    float areaCost = 0.0f; // Smoothed milliseconds at scale 1
+};
@@ -0,0 +1,200 @@
+#pragma once
+
+// GL side of dynamic resolution: a GPU frame timer built on GL_TIME_ELAPSED
+// queries and an offscreen target the scene renders into at a fraction of
+// the window size, upscaled to the window with a bilinear + sharpen pass.
+//
+// The target is allocated at the full window size and the scene only uses
+// its lower left corner, so changing the scale never reallocates anything.
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// Timer queries in flight; results are read a few frames late so the CPU
+// never waits for the GPU. Each query carries a tag (the render scale) so a
+// late result can be matched to the frame it measured.
+const int GPU_FRAME_TIMER_QUERIES = 4;
+
+class GpuFrameTimer {
+public:
+    void init() {
+        glGenQueries(GPU_FRAME_TIMER_QUERIES, queries);
+    }
+
+    void begin(float tag) {
+        // All queries still in flight: skip this frame rather than stall
+        active = pending < GPU_FRAME_TIMER_QUERIES;
+        if (!active)
+            return;
+        int slot = (oldest + pending) % GPU_FRAME_TIMER_QUERIES;
+        tags[slot] = tag;
+        glBeginQuery(GL_TIME_ELAPSED, queries[slot]);
+    }
+
+    void end() {
+        if (!active)
+            return;
+        glEndQuery(GL_TIME_ELAPSED);
+        ++pending;
+        active = false;
+    }
+
+    // Oldest finished measurement, false if none is ready yet
+    bool read(float& milliseconds, float& tag) {
+        if (pending == 0)
+            return false;
+        GLint available = 0;
+        glGetQueryObjectiv(queries[oldest], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            return false;
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(queries[oldest], GL_QUERY_RESULT, &nanoseconds);
+        tag = tags[oldest];
+        oldest = (oldest + 1) % GPU_FRAME_TIMER_QUERIES;
+        --pending;
+        milliseconds = static_cast<float>(nanoseconds * 1e-6);
+        return true;
+    }
+
+    void destroy() {
+        glDeleteQueries(GPU_FRAME_TIMER_QUERIES, queries);
+        *this = GpuFrameTimer();
+    }
+
+private:
+    GLuint queries[GPU_FRAME_TIMER_QUERIES] = {};
+    float tags[GPU_FRAME_TIMER_QUERIES] = {};
+    int oldest = 0;
+    int pending = 0;
+    bool active = false;
+};
+
+// Full-screen triangle from gl_VertexID, no vertex buffer
+const char* const UPSCALE_VERTEX_SHADER_SOURCE = R"glsl(
+    #version 330 core
+    out vec2 screenCoord;
+    void main() {
+        vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+        screenCoord = corner;
+        gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+    }
+)glsl";
+
+// Bilinear sample of the rendered corner plus an unsharp mask against the
+// four neighbours one source texel away. Samples are clamped inside the
+// rendered region so the unused part of the texture never bleeds in.
+const char* const UPSCALE_FRAGMENT_SHADER_SOURCE = R"glsl(
+    #version 330 core
+    in vec2 screenCoord;
+    out vec4 FragColor;
+    uniform sampler2D source;
+    uniform vec2 regionSize;   // Rendered size in texels
+    uniform float sharpness;   // 0 = plain bilinear
+
+    vec3 fetch(vec2 texel) {
+        texel = clamp(texel, vec2(0.5), regionSize - 0.5);
+        return texture(source, texel / vec2(textureSize(source, 0))).rgb;
+    }
+
+    void main() {
+        vec2 texel = screenCoord * regionSize;
+        vec3 center = fetch(texel);
+        vec3 neighbours = fetch(texel + vec2(1.0, 0.0)) + fetch(texel - vec2(1.0, 0.0)) +
+            fetch(texel + vec2(0.0, 1.0)) + fetch(texel - vec2(0.0, 1.0));
+        FragColor = vec4(clamp(center + sharpness * (4.0 * center - neighbours), 0.0, 1.0), 1.0);
+    }
+)glsl";
+
+class ScaledRenderTarget {
+public:
+    // Takes ownership of `linkedProgram`, built from the two UPSCALE_ sources
+    void init(GLuint linkedProgram) {
+        program = linkedProgram;
+        regionSizeLoc = glGetUniformLocation(program, "regionSize");
+        sharpnessLoc = glGetUniformLocation(program, "sharpness");
+        glUseProgram(program);
+        glUniform1i(glGetUniformLocation(program, "source"), 0);
+        glUseProgram(0);
+        glGenVertexArrays(1, &emptyVertexArray);
+        glGenFramebuffers(1, &framebuffer);
+        glGenTextures(1, &colorTexture);
+        glGenRenderbuffers(1, &depthBuffer);
+    }
+
+    // Reallocate for a new window size; a no-op if the size is unchanged
+    void resize(int width, int height) {
+        if (width == targetWidth && height == targetHeight)
+            return;
+        targetWidth = width;
+        targetHeight = height;
+        glBindTexture(GL_TEXTURE_2D, colorTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            std::cerr << "ERROR::FRAMEBUFFER::INCOMPLETE " << width << "x" << height << std::endl;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    // Render the scene into the lower left `scale` of the target from here on
+    void bind(float scale) {
+        regionWidth = std::max(1, static_cast<int>(std::lround(targetWidth * scale)));
+        regionHeight = std::max(1, static_cast<int>(std::lround(targetHeight * scale)));
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glViewport(0, 0, regionWidth, regionHeight);
+    }
+
+    // Draw the rendered region over the whole default framebuffer
+    void upscale(float sharpness) const {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, targetWidth, targetHeight);
+        glDisable(GL_DEPTH_TEST);
+        glUseProgram(program);
+        glUniform2f(regionSizeLoc, static_cast<float>(regionWidth), static_cast<float>(regionHeight));
+        // Nothing to sharpen when the region is the full size
+        bool scaled = regionWidth != targetWidth || regionHeight != targetHeight;
+        glUniform1f(sharpnessLoc, scaled ? sharpness : 0.0f);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, colorTexture);
+        glBindVertexArray(emptyVertexArray);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glBindVertexArray(0);
+        glEnable(GL_DEPTH_TEST);
+    }
+
+    int renderWidth() const { return regionWidth; }
+    int renderHeight() const { return regionHeight; }
+
+    void destroy() {
+        glDeleteProgram(program);
+        glDeleteVertexArrays(1, &emptyVertexArray);
+        glDeleteFramebuffers(1, &framebuffer);
+        glDeleteTextures(1, &colorTexture);
+        glDeleteRenderbuffers(1, &depthBuffer);
+        *this = ScaledRenderTarget();
+    }
+
+private:
+    GLuint program = 0;
+    GLint regionSizeLoc = -1;
+    GLint sharpnessLoc = -1;
+    GLuint emptyVertexArray = 0;
+    GLuint framebuffer = 0;
+    GLuint colorTexture = 0;
+    GLuint depthBuffer = 0;
+    int targetWidth = 0;
+    int targetHeight = 0;
+    int regionWidth = 0;
+    int regionHeight = 0;
+};
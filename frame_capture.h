@@ -0,0 +1,359 @@
+#pragma once
+
+// CPU side of frame capture (frame_capture_gl.h): PNG and raw encoding, and
+// the writer thread that hands captured frames to a sink (image files here,
+// a video stream in video_capture.h) off the render thread.
+//
+// PNGs are compressed with a small single-pass deflate: fixed Huffman codes
+// and only two match candidates per byte, the previous pixel and the pixel
+// above. Rendered frames are mostly flat color, so this gets most of what
+// zlib would at a fraction of the time, which is what makes capturing every
+// frame affordable.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+enum class CaptureFormat {
+    Png,
+    Raw // Top-down RGBA8, no header; the size is in the file name
+};
+
+namespace capturedetail {
+
+inline uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+    static const std::vector<uint32_t> table = [] {
+        std::vector<uint32_t> result(256);
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            result[n] = c;
+        }
+        return result;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i)
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+inline uint32_t adler32(const uint8_t* data, size_t size) {
+    uint32_t a = 1, b = 0;
+    while (size > 0) {
+        // 5552 bytes is the most that can be summed before b overflows
+        size_t block = std::min<size_t>(size, 5552);
+        for (size_t i = 0; i < block; ++i) {
+            a += data[i];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+        data += block;
+        size -= block;
+    }
+    return (b << 16) | a;
+}
+
+// Deflate's bit order: values LSB first, Huffman codes MSB first
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : out(out) {}
+
+    void bits(uint32_t value, int count) {
+        buffer |= static_cast<uint64_t>(value) << filled;
+        filled += count;
+        while (filled >= 8) {
+            out.push_back(static_cast<uint8_t>(buffer));
+            buffer >>= 8;
+            filled -= 8;
+        }
+    }
+
+    void code(uint32_t code, int length) {
+        uint32_t reversed = 0;
+        for (int i = 0; i < length; ++i)
+            reversed |= ((code >> i) & 1) << (length - 1 - i);
+        bits(reversed, length);
+    }
+
+    void flush() {
+        if (filled > 0)
+            out.push_back(static_cast<uint8_t>(buffer));
+        buffer = 0;
+        filled = 0;
+    }
+
+private:
+    std::vector<uint8_t>& out;
+    uint64_t buffer = 0;
+    int filled = 0;
+};
+
+// Fixed literal/length code (RFC 1951, 3.2.6)
+inline void writeSymbol(BitWriter& writer, uint32_t symbol) {
+    if (symbol < 144)
+        writer.code(0x30 + symbol, 8);
+    else if (symbol < 256)
+        writer.code(0x190 + symbol - 144, 9);
+    else if (symbol < 280)
+        writer.code(symbol - 256, 7);
+    else
+        writer.code(0xC0 + symbol - 280, 8);
+}
+
+inline void writeMatch(BitWriter& writer, uint32_t length, uint32_t distance) {
+    static const uint16_t lengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59,
+        67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    static const uint8_t lengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4,
+        5, 5, 5, 5, 0 };
+    static const uint16_t distanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385,
+        513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    static const uint8_t distanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10,
+        10, 11, 11, 12, 12, 13, 13 };
+    int l = 28;
+    while (lengthBase[l] > length)
+        --l;
+    writeSymbol(writer, 257 + l);
+    writer.bits(length - lengthBase[l], lengthExtra[l]);
+    int d = 29;
+    while (distanceBase[d] > distance)
+        --d;
+    writer.code(d, 5);
+    writer.bits(distance - distanceBase[d], distanceExtra[d]);
+}
+
+// zlib stream of one fixed-Huffman block. Matches are only looked for
+// `pixelBytes` and `rowBytes` back.
+inline void deflateImage(const std::vector<uint8_t>& data, size_t pixelBytes, size_t rowBytes,
+    std::vector<uint8_t>& out) {
+    out.push_back(0x78); // Deflate, 32 KB window
+    out.push_back(0x01);
+    BitWriter writer(out);
+    writer.bits(1, 1); // Final block
+    writer.bits(1, 2); // Fixed Huffman codes
+    const size_t distances[2] = { pixelBytes, rowBytes <= 32768 ? rowBytes : 0 };
+    size_t i = 0;
+    while (i < data.size()) {
+        size_t bestLength = 0, bestDistance = 0;
+        size_t maxLength = std::min<size_t>(258, data.size() - i);
+        for (size_t distance : distances) {
+            if (distance == 0 || distance > i)
+                continue;
+            size_t length = 0;
+            while (length < maxLength && data[i + length] == data[i + length - distance])
+                ++length;
+            if (length > bestLength) {
+                bestLength = length;
+                bestDistance = distance;
+            }
+        }
+        if (bestLength >= 3) {
+            writeMatch(writer, static_cast<uint32_t>(bestLength), static_cast<uint32_t>(bestDistance));
+            i += bestLength;
+        } else {
+            writeSymbol(writer, data[i++]);
+        }
+    }
+    writeSymbol(writer, 256); // End of block
+    writer.flush();
+    uint32_t adler = adler32(data.data(), data.size());
+    for (int shift = 24; shift >= 0; shift -= 8)
+        out.push_back(static_cast<uint8_t>(adler >> shift));
+}
+
+inline void appendChunk(std::vector<uint8_t>& png, const char* type, const std::vector<uint8_t>& data) {
+    uint32_t size = static_cast<uint32_t>(data.size());
+    for (int shift = 24; shift >= 0; shift -= 8)
+        png.push_back(static_cast<uint8_t>(size >> shift));
+    size_t start = png.size();
+    png.insert(png.end(), type, type + 4);
+    png.insert(png.end(), data.begin(), data.end());
+    uint32_t crc = crc32(png.data() + start, png.size() - start);
+    for (int shift = 24; shift >= 0; shift -= 8)
+        png.push_back(static_cast<uint8_t>(crc >> shift));
+}
+
+} // namespace capturedetail
+
+// PNG of an RGBA8 image, bottom-up as glReadPixels returns it unless
+// `bottomUp` is false. Alpha is kept.
+inline std::vector<uint8_t> encodePng(uint32_t width, uint32_t height, const uint8_t* pixels, bool bottomUp = true) {
+    using namespace capturedetail;
+    size_t rowBytes = static_cast<size_t>(width) * 4;
+    // Filter type 0 before every row, rows in top-down order
+    std::vector<uint8_t> filtered;
+    filtered.reserve((rowBytes + 1) * height);
+    for (uint32_t row = 0; row < height; ++row) {
+        uint32_t y = bottomUp ? height - 1 - row : row;
+        filtered.push_back(0);
+        filtered.insert(filtered.end(), pixels + y * rowBytes, pixels + (y + 1) * rowBytes);
+    }
+
+    std::vector<uint8_t> header = { 0, 0, 0, 0, 0, 0, 0, 0,
+        8, 6, 0, 0, 0 }; // 8 bits per channel, RGBA, deflate, no interlace
+    for (int i = 0; i < 4; ++i) {
+        header[i] = static_cast<uint8_t>(width >> (24 - 8 * i));
+        header[4 + i] = static_cast<uint8_t>(height >> (24 - 8 * i));
+    }
+    std::vector<uint8_t> compressed;
+    deflateImage(filtered, 4, rowBytes + 1, compressed);
+
+    std::vector<uint8_t> png = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    appendChunk(png, "IHDR", header);
+    appendChunk(png, "IDAT", compressed);
+    appendChunk(png, "IEND", {});
+    return png;
+}
+
+// `prefix`_000042.png, or `prefix`_000042_800x600.rgba for raw frames
+inline std::string capturePath(const std::string& prefix, CaptureFormat format, uint64_t frame, uint32_t width,
+    uint32_t height) {
+    char number[32];
+    std::snprintf(number, sizeof(number), "_%06llu", static_cast<unsigned long long>(frame));
+    if (format == CaptureFormat::Png)
+        return prefix + number + ".png";
+    return prefix + number + "_" + std::to_string(width) + "x" + std::to_string(height) + ".rgba";
+}
+
+// Encode and write one bottom-up RGBA8 frame
+inline bool writeCapture(const std::string& path, CaptureFormat format, uint32_t width, uint32_t height,
+    const uint8_t* pixels) {
+    std::ofstream file(path, std::ios::binary);
+    if (format == CaptureFormat::Png) {
+        std::vector<uint8_t> png = encodePng(width, height, pixels);
+        file.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+    } else {
+        size_t rowBytes = static_cast<size_t>(width) * 4;
+        for (uint32_t y = height; y-- > 0;)
+            file.write(reinterpret_cast<const char*>(pixels + y * rowBytes), static_cast<std::streamsize>(rowBytes));
+    }
+    return static_cast<bool>(file);
+}
+
+// A frame on its way to disk. The pixels are either owned, or still in a
+// persistently mapped pack buffer: the writer copies them out first and then
+// clears `mappedBusy`, handing the buffer back to the render thread.
+struct CapturedFrame {
+    uint64_t frame = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixels;             // Bottom-up RGBA8
+    const uint8_t* mapped = nullptr;
+    std::atomic<bool>* mappedBusy = nullptr;
+};
+
+// Consumes one frame on the writer thread; false counts as a failed write
+using CaptureSink = std::function<bool(const CapturedFrame&)>;
+
+// Sink writing every frame to its own file, named by capturePath()
+inline CaptureSink imageFileSink(const std::string& prefix, CaptureFormat format) {
+    return [prefix, format](const CapturedFrame& frame) {
+        return writeCapture(capturePath(prefix, format, frame.frame, frame.width, frame.height), format, frame.width,
+            frame.height, frame.pixels.data());
+    };
+}
+
+// Passes captured frames to a sink on its own thread. The queue is bounded:
+// when the sink cannot keep up, trySubmit() fails and the caller drops
+// frames instead of growing memory or stalling the render loop.
+class CaptureWriter {
+public:
+    CaptureWriter() = default;
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    ~CaptureWriter() {
+        finish();
+    }
+
+    void start(CaptureSink frameSink, size_t maxQueued = 4) {
+        sink = std::move(frameSink);
+        capacity = std::max<size_t>(maxQueued, 1);
+        running = true;
+        thread = std::thread([this] { writerLoop(); });
+    }
+
+    bool trySubmit(CapturedFrame& frame) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.size() >= capacity)
+            return false;
+        queue.push_back(std::move(frame));
+        wake.notify_one();
+        return true;
+    }
+
+    // Blocks until there is room; for the last frames at shutdown
+    void submit(CapturedFrame& frame) {
+        std::unique_lock<std::mutex> lock(mutex);
+        room.wait(lock, [this] { return queue.size() < capacity; });
+        queue.push_back(std::move(frame));
+        wake.notify_one();
+    }
+
+    // Write everything queued, then stop the thread
+    void finish() {
+        if (!thread.joinable())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        wake.notify_one();
+        thread.join();
+    }
+
+    bool full() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return queue.size() >= capacity;
+    }
+
+    uint64_t writtenCount() const { return written.load(); }
+    uint64_t failedCount() const { return failed.load(); }
+
+private:
+    void writerLoop() {
+        for (;;) {
+            CapturedFrame frame;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return !queue.empty() || !running; });
+                if (queue.empty())
+                    return;
+                frame = std::move(queue.front());
+                queue.pop_front();
+            }
+            room.notify_one();
+            if (frame.mapped) {
+                frame.pixels.assign(frame.mapped, frame.mapped + static_cast<size_t>(frame.width) * frame.height * 4);
+                frame.mappedBusy->store(false, std::memory_order_release);
+            }
+            if (sink(frame))
+                ++written;
+            else
+                ++failed;
+        }
+    }
+
+    CaptureSink sink;
+    size_t capacity = 4;
+    std::thread thread;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable room;
+    std::deque<CapturedFrame> queue; // guarded by mutex
+    bool running = false;            // guarded by mutex
+    std::atomic<uint64_t> written{ 0 };
+    std::atomic<uint64_t> failed{ 0 };
+};
@@ -0,0 +1,200 @@
+#pragma once
+
+// Frame capture without stalling the pipeline. glReadPixels into a pixel
+// pack buffer only queues a copy on the GPU; a fence after it tells when
+// the copy is done. poll() checks the oldest fences without waiting, so a
+// capture is picked up a frame or two later, once the GPU got to it.
+//
+// With buffer storage the pack buffers stay persistently mapped and the
+// writer thread (frame_capture.h) copies the pixels out itself; otherwise
+// the render thread maps, copies and unmaps. Encoding and file writes run in
+// the writer's sink, never on the render thread. When every buffer of the ring is still in use,
+// a capture is dropped rather than waited for.
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "frame_capture.h"
+#include "gl_resources.h"
+
+class FrameCapture {
+public:
+    FrameCapture() = default;
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Frames go to `sink` on the writer thread, e.g. imageFileSink();
+    // `ringSize` pack buffers may be in flight at once
+    void init(CaptureSink sink, uint32_t ringSize = 3) {
+        persistent = hasBufferStorage();
+        for (uint32_t i = 0; i < std::max<uint32_t>(ringSize, 1); ++i)
+            slots.push_back(std::make_unique<Slot>());
+        writer.start(std::move(sink));
+    }
+
+    bool enabled() const { return !slots.empty(); }
+
+    // Queue a copy of `framebuffer`'s color buffer (0: the back buffer).
+    // Returns false when the frame was dropped.
+    bool capture(uint32_t width, uint32_t height, uint64_t frame, GLuint framebuffer = 0) {
+        Slot* slot = nullptr;
+        for (auto& candidate : slots) {
+            if (!candidate->pending && !candidate->busy.load(std::memory_order_acquire)) {
+                slot = candidate.get();
+                break;
+            }
+        }
+        if (!slot || width == 0 || height == 0) {
+            ++dropped;
+            return false;
+        }
+
+        size_t bytes = static_cast<size_t>(width) * height * 4;
+        if (bytes > slot->capacity)
+            resize(*slot, bytes);
+        GLint previousFramebuffer = 0;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->buffer);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glReadPixels(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height), GL_RGBA, GL_UNSIGNED_BYTE,
+            nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+
+        slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        slot->width = width;
+        slot->height = height;
+        slot->frame = frame;
+        slot->pending = true;
+        slot->busy.store(true, std::memory_order_relaxed);
+        order.push_back(slot);
+        ++captured;
+        return true;
+    }
+
+    // Hand finished copies to the writer, oldest first; never waits for the GPU
+    void poll() {
+        while (!order.empty() && !writer.full()) {
+            Slot& slot = *order.front();
+            GLenum status = glClientWaitSync(slot.fence, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+                break;
+            submit(slot, false);
+        }
+    }
+
+    // Write out every capture still in flight and stop the writer
+    void flush() {
+        while (!order.empty()) {
+            Slot& slot = *order.front();
+            glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+            submit(slot, true);
+        }
+        writer.finish();
+    }
+
+    uint64_t capturedCount() const { return captured; }
+    uint64_t droppedCount() const { return dropped; }
+    uint64_t writtenCount() const { return writer.writtenCount(); }
+    uint64_t failedCount() const { return writer.failedCount(); }
+
+    void destroy() {
+        flush();
+        for (auto& slot : slots) {
+            if (slot->mapped) {
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->buffer);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+            glDeleteBuffers(1, &slot->buffer);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        slots.clear();
+    }
+
+private:
+    struct Slot {
+        GLuint buffer = 0;
+        size_t capacity = 0;
+        const uint8_t* mapped = nullptr; // Persistent mapping, if any
+        GLsync fence = nullptr;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint64_t frame = 0;
+        bool pending = false;            // Copy queued, not handed to the writer yet
+        std::atomic<bool> busy{ false }; // Until the writer has copied the pixels
+    };
+
+    // Only called on idle slots, so nothing reads the old buffer any more
+    void resize(Slot& slot, size_t bytes) {
+        if (slot.mapped) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &slot.buffer);
+        slot.capacity = bytes;
+        slot.mapped = nullptr;
+        if (persistent) {
+            const GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            slot.buffer = createBuffer(bytes, nullptr, flags);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+            slot.mapped = static_cast<const uint8_t*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+                static_cast<GLsizeiptr>(bytes), flags));
+        } else {
+            glGenBuffers(1, &slot.buffer);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+            glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    // The fence of `slot` has signaled
+    void submit(Slot& slot, bool wait) {
+        CapturedFrame frame;
+        frame.frame = slot.frame;
+        frame.width = slot.width;
+        frame.height = slot.height;
+        size_t bytes = static_cast<size_t>(slot.width) * slot.height * 4;
+        if (slot.mapped) {
+            frame.mapped = slot.mapped;
+            frame.mappedBusy = &slot.busy;
+        } else {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+            const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes),
+                GL_MAP_READ_BIT);
+            if (data)
+                frame.pixels.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + bytes);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            slot.busy.store(false, std::memory_order_release);
+        }
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+        slot.pending = false;
+        order.pop_front();
+        if (!frame.mapped && frame.pixels.empty()) {
+            ++dropped; // The mapping failed
+            return;
+        }
+        if (wait) {
+            writer.submit(frame);
+        } else if (!writer.trySubmit(frame)) {
+            // poll() checked for room, but never leave a slot busy
+            slot.busy.store(false, std::memory_order_release);
+            ++dropped;
+        }
+    }
+
+    bool persistent = false;
+    std::vector<std::unique_ptr<Slot>> slots;
+    std::deque<Slot*> order; // Pending slots, oldest first
+    CaptureWriter writer;
+    uint64_t captured = 0;
+    uint64_t dropped = 0;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+// Frame rate cap. Sleeping alone overshoots by the OS timer granularity (up
+// to ~15 ms on Windows), spinning alone keeps a core busy, so the pacer
+// sleeps until shortly before the deadline and spins the rest. The sleep
+// margin follows the oversleep measured on this machine.
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Frames per second, 0 = no cap
+    void setFrameRate(double framesPerSecond) {
+        interval = framesPerSecond > 0.0
+            ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / framesPerSecond))
+            : Clock::duration::zero();
+        reset();
+    }
+
+    bool enabled() const { return interval > Clock::duration::zero(); }
+
+    // Block until the next frame is due
+    void wait() {
+        if (!enabled())
+            return;
+        Clock::time_point now = Clock::now();
+        if (now < deadline) {
+            if (deadline - now > sleepMargin) {
+                Clock::time_point wake = deadline - sleepMargin;
+                std::this_thread::sleep_until(wake);
+                adaptMargin(Clock::now() - wake);
+            }
+            while (Clock::now() < deadline)
+                std::this_thread::yield();
+            now = deadline;
+        }
+        // Step from the deadline so the average rate is exact, but do not try
+        // to catch up after a long frame
+        deadline += interval;
+        if (deadline < now)
+            deadline = now + interval;
+    }
+
+    // Start a new schedule, e.g. after the loop was blocked waiting for events
+    void reset() { deadline = Clock::now() + interval; }
+
+private:
+    // Jump up to the worst oversleep at once, decay slowly back down
+    void adaptMargin(Clock::duration oversleep) {
+        const Clock::duration minMargin = std::chrono::microseconds(500);
+        const Clock::duration maxMargin = std::chrono::milliseconds(20);
+        if (oversleep > sleepMargin)
+            sleepMargin = oversleep;
+        else
+            sleepMargin -= (sleepMargin - oversleep) / 16;
+        sleepMargin = std::min(std::max(sleepMargin, minMargin), maxMargin);
+    }
+
+    Clock::duration interval = Clock::duration::zero();
+    Clock::time_point deadline = Clock::now();
+    Clock::duration sleepMargin = std::chrono::milliseconds(2);
+};
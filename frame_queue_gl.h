@@ -0,0 +1,46 @@
+#pragma once
+
+// Limits how many frames the driver may queue ahead of the GPU. Drivers
+// happily buffer two or three frames, which keeps the GPU busy but adds a
+// frame of input latency for each. A fence is inserted after every swap and
+// the CPU waits on the oldest one before starting a frame once `limit` are
+// outstanding. A limit of 0 is the strictest form: glFinish after each swap.
+
+#include <GL/glew.h>
+#include <deque>
+
+class FrameQueueLimiter {
+public:
+    // Frames allowed in flight; negative leaves the queue to the driver
+    void setLimit(int frames) { limit = frames; }
+
+    bool enabled() const { return limit >= 0; }
+
+    // Call right after the swap
+    void frameSubmitted() {
+        if (limit == 0)
+            glFinish();
+        else if (limit > 0)
+            fences.push_back(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    }
+
+    // Call before sampling input for the next frame; blocks while the queue is full
+    void waitForSlot() {
+        while (limit > 0 && static_cast<int>(fences.size()) >= limit) {
+            // The flush bit submits the fence, so the wait cannot hang on unflushed commands
+            glClientWaitSync(fences.front(), GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+            glDeleteSync(fences.front());
+            fences.pop_front();
+        }
+    }
+
+    void destroy() {
+        for (GLsync fence : fences)
+            glDeleteSync(fence);
+        *this = FrameQueueLimiter();
+    }
+
+private:
+    int limit = -1;
+    std::deque<GLsync> fences;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+// Frame time log for benchmark runs: keeps every frame's duration and prints
+// a summary that can be compared across builds. Also used for other per-event
+// times such as input latency.
+
+#include <algorithm>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class FrameTimeLog {
+public:
+    void add(double milliseconds) { frames.push_back(milliseconds); }
+    size_t count() const { return frames.size(); }
+
+    // Percentile in [0, 100] of the recorded frame times
+    double percentile(double p) const {
+        if (frames.empty())
+            return 0.0;
+        std::vector<double> sorted(frames);
+        std::sort(sorted.begin(), sorted.end());
+        size_t index = static_cast<size_t>(p / 100.0 * (sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+
+    double mean() const {
+        double total = 0.0;
+        for (double frame : frames)
+            total += frame;
+        return frames.empty() ? 0.0 : total / frames.size();
+    }
+
+    void printSummary(std::ostream& out, const std::string& label, const std::string& countName = "frames") const {
+        out << label << ": " << frames.size() << " " << countName << ", mean " << mean() << " ms, p50 " << percentile(50.0)
+            << " ms, p99 " << percentile(99.0) << " ms, max " << percentile(100.0) << " ms" << std::endl;
+    }
+
+    // One time per line, in milliseconds
+    bool writeCsv(const std::string& path, const std::string& indexName = "frame") const {
+        std::ofstream file(path);
+        file << indexName << ",ms\n";
+        for (size_t i = 0; i < frames.size(); ++i)
+            file << i << "," << frames[i] << "\n";
+        return static_cast<bool>(file);
+    }
+
+private:
+    std::vector<double> frames;
+};
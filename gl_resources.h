@@ -0,0 +1,302 @@
+#pragma once
+
+// Buffer and vertex array creation without bind-to-edit. On OpenGL 4.5 (or
+// ARB_direct_state_access) objects are created and filled by name:
+// glCreateBuffers, glNamedBufferStorage, glVertexArrayVertexBuffer,
+// glVertexArrayAttribFormat. Nothing gets bound, so setup code cannot
+// disturb the state a pass relies on. Older contexts take the classic path;
+// it binds through GL_COPY_WRITE_BUFFER and puts the vertex array and array
+// buffer bindings back the way it found them.
+//
+// Buffers use immutable storage (glBufferStorage) wherever it exists, so the
+// driver never has to expect a reallocation. StreamBuffer keeps the per-frame
+// uploads in immutable storage too: the buffer stays persistently mapped and
+// frames rotate through a few fenced segments, written through the pointer,
+// instead of orphaning the buffer with glBufferData every frame.
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+inline bool hasBufferStorage() {
+    return GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+}
+
+// The extension only brings the named storage and vertex binding entry
+// points along when the context has those features too
+inline bool hasDirectStateAccess() {
+    return GLEW_VERSION_4_5 || (GLEW_ARB_direct_state_access && GLEW_VERSION_4_4);
+}
+
+// A buffer of `bytes`, filled with `data` when it is not null. `flags` are
+// glBufferStorage flags: 0 for data that never changes, GL_DYNAMIC_STORAGE_BIT
+// for contents updated with writeBuffer(). `data` may point into a file
+// mapping; the driver reads it directly, there is no staging copy here.
+inline GLuint createBuffer(size_t bytes, const void* data, GLbitfield flags = 0) {
+    GLuint buffer = 0;
+    GLsizeiptr size = static_cast<GLsizeiptr>(std::max<size_t>(bytes, 1));
+    if (hasDirectStateAccess()) {
+        glCreateBuffers(1, &buffer);
+        glNamedBufferStorage(buffer, size, data, flags);
+        return buffer;
+    }
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    if (hasBufferStorage())
+        glBufferStorage(GL_COPY_WRITE_BUFFER, size, data, flags);
+    else
+        glBufferData(GL_COPY_WRITE_BUFFER, size, data,
+            (flags & GL_DYNAMIC_STORAGE_BIT) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return buffer;
+}
+
+// Update part of a buffer created with GL_DYNAMIC_STORAGE_BIT
+inline void writeBuffer(GLuint buffer, size_t offset, size_t bytes, const void* data) {
+    if (bytes == 0)
+        return;
+    if (hasDirectStateAccess()) {
+        glNamedBufferSubData(buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes), data);
+        return;
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes), data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+// Describes a vertex array, then creates it in one go. Attributes read from
+// numbered buffer bindings, the GL 4.3 vertex binding model; the fallback
+// turns each attribute into a glVertexAttribPointer call.
+class VertexArrayBuilder {
+public:
+    // Buffer read by the attributes of `binding`; divisor 1 steps once per instance
+    VertexArrayBuilder& buffer(GLuint binding, GLuint bufferId, size_t offset, GLsizei stride, GLuint divisor = 0) {
+        bindings.push_back({ binding, bufferId, offset, stride, divisor });
+        return *this;
+    }
+
+    // Float attribute, converted from `type` (normalized if asked)
+    VertexArrayBuilder& attribute(GLuint location, GLuint binding, GLint size, GLenum type, bool normalized,
+        GLuint relativeOffset) {
+        attributes.push_back({ location, binding, size, type, normalized, relativeOffset });
+        return *this;
+    }
+
+    // A mat4 in four consecutive locations, one column each
+    VertexArrayBuilder& matrixAttribute(GLuint location, GLuint binding) {
+        for (GLuint column = 0; column < 4; ++column)
+            attribute(location + column, binding, 4, GL_FLOAT, false, column * 4 * sizeof(float));
+        return *this;
+    }
+
+    VertexArrayBuilder& indices(GLuint bufferId) {
+        indexBuffer = bufferId;
+        return *this;
+    }
+
+    GLuint create() const {
+        GLuint vertexArray = 0;
+        if (hasDirectStateAccess()) {
+            glCreateVertexArrays(1, &vertexArray);
+            for (const Binding& binding : bindings) {
+                glVertexArrayVertexBuffer(vertexArray, binding.index, binding.buffer,
+                    static_cast<GLintptr>(binding.offset), binding.stride);
+                if (binding.divisor)
+                    glVertexArrayBindingDivisor(vertexArray, binding.index, binding.divisor);
+            }
+            for (const Attribute& attribute : attributes) {
+                glEnableVertexArrayAttrib(vertexArray, attribute.location);
+                glVertexArrayAttribFormat(vertexArray, attribute.location, attribute.size, attribute.type,
+                    attribute.normalized ? GL_TRUE : GL_FALSE, attribute.relativeOffset);
+                glVertexArrayAttribBinding(vertexArray, attribute.location, attribute.binding);
+            }
+            if (indexBuffer)
+                glVertexArrayElementBuffer(vertexArray, indexBuffer);
+            return vertexArray;
+        }
+
+        GLint previousVertexArray = 0, previousArrayBuffer = 0;
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &previousVertexArray);
+        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &previousArrayBuffer);
+        glGenVertexArrays(1, &vertexArray);
+        glBindVertexArray(vertexArray);
+        for (const Attribute& attribute : attributes) {
+            const Binding* binding = findBinding(attribute.binding);
+            if (!binding)
+                continue;
+            glBindBuffer(GL_ARRAY_BUFFER, binding->buffer);
+            glVertexAttribPointer(attribute.location, attribute.size, attribute.type,
+                attribute.normalized ? GL_TRUE : GL_FALSE, binding->stride,
+                reinterpret_cast<const void*>(binding->offset + attribute.relativeOffset));
+            glEnableVertexAttribArray(attribute.location);
+            if (binding->divisor)
+                glVertexAttribDivisor(attribute.location, binding->divisor);
+        }
+        // The element buffer binding is vertex array state, no need to restore it
+        if (indexBuffer)
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+        glBindVertexArray(static_cast<GLuint>(previousVertexArray));
+        glBindBuffer(GL_ARRAY_BUFFER, static_cast<GLuint>(previousArrayBuffer));
+        return vertexArray;
+    }
+
+private:
+    struct Binding {
+        GLuint index;
+        GLuint buffer;
+        size_t offset;
+        GLsizei stride;
+        GLuint divisor;
+    };
+
+    struct Attribute {
+        GLuint location;
+        GLuint binding;
+        GLint size;
+        GLenum type;
+        bool normalized;
+        GLuint relativeOffset;
+    };
+
+    const Binding* findBinding(GLuint index) const {
+        for (const Binding& binding : bindings) {
+            if (binding.index == index)
+                return &binding;
+        }
+        return nullptr;
+    }
+
+    std::vector<Binding> bindings;
+    std::vector<Attribute> attributes;
+    GLuint indexBuffer = 0;
+};
+
+// Per-frame data in immutable storage, mapped once for the buffer's whole
+// life (persistent and coherent). Each frame writes the next of `segments`
+// equally sized slices straight through the pointer, so the GPU can still
+// read the previous frames' slices; the offset of this frame's slice is what
+// gets bound. A fence goes in behind each slice when the next one starts, and
+// a slice is only written again once its fence has signalled. The buffer is
+// only recreated when a frame needs more than a slice holds. Without buffer
+// storage there is one slice, orphaned every frame and filled with
+// glBufferSubData.
+class StreamBuffer {
+public:
+    // `alignment`: slice offsets must be multiples of it (uniform or storage
+    // buffer offset alignment); `segments` of 1 keeps the offset at 0
+    void init(size_t alignment, uint32_t segments = 3) {
+        sliceAlignment = std::max<size_t>(alignment, 1);
+        segmentCount = hasBufferStorage() ? std::max<uint32_t>(segments, 1) : 1;
+    }
+
+    // Start this frame's slice, large enough for `bytes`; returns its offset.
+    // Blocks while the GPU still reads that slice from `segments` frames ago.
+    size_t begin(size_t bytes) {
+        size_t needed = (std::max<size_t>(bytes, 16) + sliceAlignment - 1) / sliceAlignment * sliceAlignment;
+        if (needed > sliceSize || buffer == 0) {
+            // Deleting a buffer the GPU still reads is safe, the driver keeps it alive
+            release();
+            // Grow with headroom so a slowly rising count does not recreate every frame
+            sliceSize = std::max(needed, sliceSize * 2);
+            create();
+            current = 0;
+        } else {
+            if (mapped) {
+                // Everything that reads the finished slice has been issued by now
+                fences[current] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            }
+            current = (current + 1) % segmentCount;
+            waitForSlice(current);
+        }
+        if (!hasBufferStorage()) {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(sliceSize), nullptr, GL_STREAM_DRAW);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+        return offset();
+    }
+
+    // Copy into this frame's slice, `offsetInSlice` bytes from its start
+    void write(size_t offsetInSlice, const void* data, size_t bytes) const {
+        if (mapped)
+            std::memcpy(mapped + offset() + offsetInSlice, data, bytes);
+        else
+            writeBuffer(buffer, offset() + offsetInSlice, bytes, data);
+    }
+
+    GLuint id() const { return buffer; }
+    size_t offset() const { return current * sliceSize; }
+    size_t size() const { return sliceSize; }
+
+    void destroy() {
+        release();
+        *this = StreamBuffer();
+    }
+
+private:
+    void create() {
+        size_t bytes = sliceSize * segmentCount;
+        fences.assign(segmentCount, nullptr);
+        if (!hasBufferStorage()) {
+            buffer = createBuffer(bytes, nullptr, GL_DYNAMIC_STORAGE_BIT);
+            return;
+        }
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        buffer = createBuffer(bytes, nullptr, flags);
+        if (hasDirectStateAccess()) {
+            mapped = static_cast<uint8_t*>(glMapNamedBufferRange(buffer, 0, static_cast<GLsizeiptr>(bytes), flags));
+        } else {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            mapped = static_cast<uint8_t*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, static_cast<GLsizeiptr>(bytes), flags));
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+    }
+
+    void waitForSlice(uint32_t slice) {
+        GLsync& fence = fences[slice];
+        if (!fence)
+            return;
+        // Flush on the first wait so the fence cannot sit unsubmitted forever
+        GLbitfield waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+        for (;;) {
+            GLenum result = glClientWaitSync(fence, waitFlags, 1000000000ull);
+            if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED)
+                break;
+            waitFlags = 0;
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    void release() {
+        for (GLsync& fence : fences) {
+            if (fence)
+                glDeleteSync(fence);
+            fence = nullptr;
+        }
+        if (mapped) {
+            if (hasDirectStateAccess()) {
+                glUnmapNamedBuffer(buffer);
+            } else {
+                glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+                glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+                glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            }
+            mapped = nullptr;
+        }
+        if (buffer)
+            glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+
+    GLuint buffer = 0;
+    uint8_t* mapped = nullptr;
+    std::vector<GLsync> fences;
+    size_t sliceAlignment = 1;
+    size_t sliceSize = 0;
+    uint32_t segmentCount = 1;
+    uint32_t current = 0;
+};
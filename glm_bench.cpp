@@ -0,0 +1,353 @@
+// GLM micro-benchmarks for the operations the frame loop uses. The same
+// source is built once per instruction set (see the glm_bench tasks in
+// .vscode/tasks.json):
+//
+//   scalar  GLM_FORCE_PURE                 sse2  GLM_FORCE_SSE2 -msse2
+//   sse41   GLM_FORCE_SSE41 -msse4.1       avx   GLM_FORCE_AVX -mavx
+//   avx2    GLM_FORCE_AVX2 -mavx2 -mfma
+//
+// glm only takes its intrinsic paths for aligned types, and the default
+// types are packed. The SIMD builds therefore also define
+// GLM_FORCE_DEFAULT_ALIGNED_GENTYPES, so that glm::mat4, vec4, quat and the
+// rest are aligned. Each row then measures
+// glm's scalar code on packed types in the scalar column, and glm's SIMD
+// code on aligned types in the others. The array rows (mat4[]) take any
+// type and use SIMD either way. A SIMD build without the aligned define
+// says so when it starts; its numbers only show what the -m flags give
+// the compiler.
+//
+// Usage: glm_bench [--csv FILE] [--filter TEXT] [--samples N]
+//        glm_bench --report FILE
+//   --csv FILE     append "config,operation,ns" rows to FILE, so every
+//                  configuration's run lands in one file
+//   --filter TEXT  only run operations whose name contains TEXT
+//   --samples N    timed samples per operation, the median is reported (default 15)
+//   --report FILE  print the rows of FILE side by side: one line per
+//                  operation, one column per configuration, plus the
+//                  speedup of the fastest configuration over scalar
+// Every operation runs over 1024 fixed pseudo-random inputs, so results are
+// comparable between builds and machines of the same kind.
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const size_t inputCount = 1024;
+
+const char* configName() {
+#if GLM_ARCH & GLM_ARCH_AVX2_BIT
+    return "avx2";
+#elif GLM_ARCH & GLM_ARCH_AVX_BIT
+    return "avx";
+#elif GLM_ARCH & GLM_ARCH_SSE41_BIT
+    return "sse41";
+#elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+// Deterministic inputs: the same values in every configuration
+struct Inputs {
+    std::vector<glm::mat4> matrices;
+    std::vector<glm::mat3> normalInputs; // Upper 3x3 of `matrices`, built outside the timed loops
+    std::vector<glm::vec3> vectors;
+    std::vector<glm::vec4> colors;
+    std::vector<glm::quat> rotations;
+    std::vector<float> scalars;
+
+    Inputs() {
+        uint32_t state = 0x9E3779B9u;
+        auto next = [&state]() {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return static_cast<float>(state >> 8) / 16777216.0f;
+        };
+        for (size_t i = 0; i < inputCount; ++i) {
+            glm::vec3 axis = glm::normalize(glm::vec3(next() - 0.5f, next() - 0.5f, next() - 0.5f) + 0.01f);
+            glm::quat rotation = glm::angleAxis(next() * 6.28f, axis);
+            glm::vec3 position(next() * 20.0f - 10.0f, next() * 20.0f - 10.0f, next() * 20.0f - 10.0f);
+            // Rigid transforms with a scale: invertible and well conditioned
+            matrices.push_back(glm::translate(glm::mat4(1.0f), position) * glm::mat4_cast(rotation)
+                * glm::scale(glm::mat4(1.0f), glm::vec3(0.5f + next())));
+            normalInputs.push_back(glm::mat3(matrices.back()));
+            vectors.push_back(position);
+            colors.push_back(glm::vec4(next(), next(), next(), next()));
+            rotations.push_back(rotation);
+            scalars.push_back(next());
+        }
+    }
+};
+
+// Results are folded in here so the compiler cannot drop the work
+volatile float sink = 0.0f;
+
+inline void consume(float value) { sink = sink + value; }
+inline void consume(const glm::vec3& v) { consume(v.x + v.y + v.z); }
+inline void consume(const glm::vec4& v) { consume(v.x + v.y + v.z + v.w); }
+inline void consume(const glm::quat& q) { consume(q.x + q.y + q.z + q.w); }
+inline void consume(const glm::mat3& m) { consume(m[0] + m[1] + m[2]); }
+inline void consume(const glm::mat4& m) { consume(m[0] + m[1] + m[2] + m[3]); }
+inline void consume(uint32_t value) { consume(static_cast<float>(value & 0xFFFF)); }
+
+struct Benchmark {
+    const char* name;
+    // One pass over the inputs; returns the operation count
+    size_t (*run)(const Inputs& in);
+};
+
+// Each pass keeps a running value so the calls cannot be hoisted, and
+// consumes it once at the end so the loop stays free of volatile stores
+template <typename T, typename Op>
+size_t pass(T accumulator, Op op) {
+    for (size_t i = 0; i < inputCount; ++i)
+        accumulator = op(accumulator, i);
+    consume(accumulator);
+    return inputCount;
+}
+
+const Benchmark benchmarks[] = {
+    { "mat4 * mat4", [](const Inputs& in) {
+        return pass(glm::mat4(1.0f), [&](const glm::mat4& m, size_t i) { return in.matrices[i] * m * 0.5f; });
+    } },
+    { "mat4 * vec4", [](const Inputs& in) {
+        return pass(glm::vec4(1.0f), [&](const glm::vec4& v, size_t i) { return in.matrices[i] * v * 0.5f; });
+    } },
+    { "inverse(mat4)", [](const Inputs& in) {
+        return pass(glm::mat4(0.0f), [&](const glm::mat4& m, size_t i) { return m + glm::inverse(in.matrices[i]); });
+    } },
+    { "affineInverse(mat4)", [](const Inputs& in) {
+        return pass(glm::mat4(0.0f), [&](const glm::mat4& m, size_t i) {
+            return m + glm::affineInverse(in.matrices[i]);
+        });
+    } },
+    { "affineInverse(mat4[])", [](const Inputs& in) {
+        static std::vector<glm::mat4> inverses(inputCount);
+        glm::affineInverse(in.matrices.data(), inverses.data(), inputCount);
+        consume(inverses[inputCount / 2]);
+        return inputCount;
+    } },
+    { "inverseTranspose(mat3)", [](const Inputs& in) {
+        return pass(glm::mat3(0.0f), [&](const glm::mat3& m, size_t i) {
+            return m + glm::inverseTranspose(in.normalInputs[i]);
+        });
+    } },
+    { "normal matrices (mat4[])", [](const Inputs& in) {
+        static std::vector<glm::mat3> normals(inputCount);
+        glm::inverseTranspose(in.matrices.data(), normals.data(), inputCount);
+        consume(normals[inputCount / 2]);
+        return inputCount;
+    } },
+    { "transpose(mat4)", [](const Inputs& in) {
+        return pass(glm::mat4(0.0f), [&](const glm::mat4& m, size_t i) {
+            return m + glm::transpose(in.matrices[i]);
+        });
+    } },
+    { "determinant(mat4)", [](const Inputs& in) {
+        return pass(0.0f, [&](float d, size_t i) { return d + glm::determinant(in.matrices[i]); });
+    } },
+    { "lookAt", [](const Inputs& in) {
+        return pass(glm::mat4(0.0f), [&](const glm::mat4& m, size_t i) {
+            return m + glm::lookAt(in.vectors[i], in.vectors[(i + 1) % inputCount], glm::vec3(0.0f, 1.0f, 0.0f));
+        });
+    } },
+    { "perspective", [](const Inputs& in) {
+        return pass(glm::mat4(0.0f), [&](const glm::mat4& m, size_t i) {
+            return m + glm::perspective(0.5f + in.scalars[i], 1.5f, 0.1f, 100.0f);
+        });
+    } },
+    { "translate*rotate*scale", [](const Inputs& in) {
+        return pass(glm::mat4(0.0f), [&](const glm::mat4& m, size_t i) {
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), in.vectors[i]);
+            model = glm::rotate(model, in.scalars[i] * 6.28f, glm::vec3(0.0f, 0.0f, 1.0f));
+            return m + glm::scale(model, glm::vec3(1.0f, 1.0f, 0.5f + in.scalars[i]));
+        });
+    } },
+    { "slerp(quat)", [](const Inputs& in) {
+        return pass(glm::quat(1.0f, 0.0f, 0.0f, 0.0f), [&](const glm::quat& q, size_t i) {
+            return glm::slerp(in.rotations[i], in.rotations[(i + 1) % inputCount], in.scalars[i]) * 0.5f + q * 0.5f;
+        });
+    } },
+    { "mat4_cast(quat)", [](const Inputs& in) {
+        return pass(glm::mat4(0.0f), [&](const glm::mat4& m, size_t i) { return m + glm::mat4_cast(in.rotations[i]); });
+    } },
+    { "normalize(vec3)", [](const Inputs& in) {
+        return pass(glm::vec3(0.0f), [&](const glm::vec3& v, size_t i) { return v + glm::normalize(in.vectors[i]); });
+    } },
+    { "normalize(vec4)", [](const Inputs& in) {
+        return pass(glm::vec4(0.0f), [&](const glm::vec4& v, size_t i) { return v + glm::normalize(in.colors[i]); });
+    } },
+    { "cross(vec3)", [](const Inputs& in) {
+        return pass(glm::vec3(1.0f, 0.0f, 0.0f), [&](const glm::vec3& v, size_t i) {
+            return glm::cross(in.vectors[i], v) * 0.1f + v;
+        });
+    } },
+    { "dot(vec4)", [](const Inputs& in) {
+        return pass(0.0f, [&](float d, size_t i) { return d + glm::dot(in.colors[i], in.colors[(i + 1) % inputCount]); });
+    } },
+    { "packUnorm4x8", [](const Inputs& in) {
+        return pass(0u, [&](uint32_t p, size_t i) { return p ^ glm::packUnorm4x8(in.colors[i]); });
+    } },
+    { "unpackUnorm4x8", [](const Inputs&) {
+        return pass(glm::vec4(0.0f), [&](const glm::vec4& v, size_t i) {
+            return v + glm::unpackUnorm4x8(static_cast<uint32_t>(i * 2654435761u));
+        });
+    } },
+    { "packSnorm2x16", [](const Inputs& in) {
+        return pass(0u, [&](uint32_t p, size_t i) {
+            return p ^ glm::packSnorm2x16(glm::vec2(in.colors[i]) * 2.0f - 1.0f);
+        });
+    } },
+    { "packHalf1x16", [](const Inputs& in) {
+        return pass(0u, [&](uint32_t p, size_t i) { return p ^ glm::packHalf1x16(in.vectors[i].x); });
+    } },
+    { "unpackHalf1x16", [](const Inputs&) {
+        return pass(0.0f, [&](float f, size_t i) {
+            return f + glm::unpackHalf1x16(static_cast<glm::uint16>(i * 40503u) & 0x7BFF);
+        });
+    } },
+};
+
+// Nanoseconds per operation: the median of `samples` timed runs, each
+// repeating the pass until it takes at least a millisecond
+double measure(const Benchmark& benchmark, const Inputs& in, int samples) {
+    using Clock = std::chrono::steady_clock;
+    size_t repeats = 1;
+    for (;;) {
+        Clock::time_point start = Clock::now();
+        for (size_t r = 0; r < repeats; ++r)
+            benchmark.run(in);
+        if (Clock::now() - start >= std::chrono::milliseconds(1) || repeats >= (1u << 20))
+            break;
+        repeats *= 2;
+    }
+    std::vector<double> times;
+    for (int s = 0; s < samples; ++s) {
+        size_t operations = 0;
+        Clock::time_point start = Clock::now();
+        for (size_t r = 0; r < repeats; ++r)
+            operations += benchmark.run(in);
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        times.push_back(elapsed.count() / static_cast<double>(operations));
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+// Rows of several runs side by side, configurations in a fixed order
+int printReport(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Cannot read " << path << std::endl;
+        return 1;
+    }
+    const char* order[] = { "scalar", "sse2", "sse41", "avx", "avx2" };
+    std::vector<std::string> operations;
+    std::map<std::string, std::map<std::string, double>> results; // operation -> config -> ns
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string config, operation, value;
+        if (!std::getline(fields, config, ',') || !std::getline(fields, operation, ',')
+            || !std::getline(fields, value))
+            continue;
+        if (results.find(operation) == results.end())
+            operations.push_back(operation);
+        results[operation][config] = std::atof(value.c_str()); // A later run replaces an earlier one
+    }
+
+    std::cout << std::left << std::setw(26) << "ns/op";
+    for (const char* config : order)
+        std::cout << std::right << std::setw(9) << config;
+    std::cout << std::right << std::setw(10) << "best" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const std::string& operation : operations) {
+        const std::map<std::string, double>& row = results[operation];
+        std::cout << std::left << std::setw(26) << operation << std::right;
+        double best = 0.0;
+        for (const char* config : order) {
+            auto found = row.find(config);
+            if (found == row.end()) {
+                std::cout << std::setw(9) << "-";
+                continue;
+            }
+            std::cout << std::setw(9) << found->second;
+            if (best == 0.0 || found->second < best)
+                best = found->second;
+        }
+        auto scalar = row.find("scalar");
+        if (scalar != row.end() && best > 0.0)
+            std::cout << std::setw(9) << scalar->second / best << "x";
+        std::cout << std::endl;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string csvPath, filter, reportPath;
+    int samples = 15;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--csv" && hasValue)
+            csvPath = argv[++i];
+        else if (arg == "--filter" && hasValue)
+            filter = argv[++i];
+        else if (arg == "--samples" && hasValue)
+            samples = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--report" && hasValue)
+            reportPath = argv[++i];
+        else
+            std::cerr << "Unknown option: " << arg << std::endl;
+    }
+    if (!reportPath.empty())
+        return printReport(reportPath);
+
+    std::ofstream csv;
+    if (!csvPath.empty()) {
+        csv.open(csvPath, std::ios::app);
+        if (!csv) {
+            std::cerr << "Cannot open " << csvPath << std::endl;
+            return 1;
+        }
+    }
+    Inputs inputs;
+    const bool aligned = glm::detail::is_aligned<glm::defaultp>::value;
+    std::cout << "glm " << configName() << (aligned ? ", aligned" : ", packed") << " types, median of " << samples
+        << " samples" << std::endl;
+#if GLM_ARCH & GLM_ARCH_SIMD_BIT
+    if (!aligned)
+        std::cerr << "Warning: packed default types, glm's SIMD paths are not used; build with "
+            "GLM_FORCE_DEFAULT_ALIGNED_GENTYPES" << std::endl;
+#endif
+    for (const Benchmark& benchmark : benchmarks) {
+        if (!filter.empty() && std::string(benchmark.name).find(filter) == std::string::npos)
+            continue;
+        double ns = measure(benchmark, inputs, samples);
+        std::cout << std::left << std::setw(26) << benchmark.name << std::right << std::fixed << std::setprecision(2)
+            << std::setw(9) << ns << " ns" << std::endl;
+        if (csv.is_open())
+            csv << configName() << "," << benchmark.name << "," << ns << "\n";
+    }
+    return 0;
+}
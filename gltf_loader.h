@@ -0,0 +1,661 @@
+#pragma once
+
+// glTF 2.0 loader for .gltf (external .bin or data: URIs) and .glb files.
+//
+// Vertex data is not re-packed into the Vertex layout: every bufferView that
+// meshes reference becomes one immutable GL buffer, uploaded straight from
+// the mapped .bin/.glb, and accessors turn into vertex buffer bindings and
+// attribute formats (gl_resources.h) with their own component type,
+// normalization, stride and offset. Index accessors bind the same way. Node transforms are flattened into per-draw
+// instance matrices (vertex attributes 3-6); EXT_mesh_gpu_instancing adds
+// its TRANSLATION/ROTATION/SCALE instances on top.
+//
+// Buffer decoding, accessor validation/bounds and instance matrices are
+// computed on the job system; only the GL upload runs on the caller's thread.
+// glTF is Y-up, the scene is Z-up, so the root is rotated +90 degrees about X.
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "gpu_mesh.h"
+#include "job_system.h"
+#include "json.h"
+#include "mesh_format.h"
+#include "mesh_import.h"
+#include "scene.h"
+
+// GL objects of a loaded glTF scene; draws still need program and uniform
+// locations filled in by the caller
+struct GltfModel {
+    std::vector<GLuint> buffers;
+    std::vector<GLuint> vertexArrays;
+    std::vector<DrawItem> draws;
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+};
+
+namespace gltfdetail {
+
+const uint32_t GLB_MAGIC = 0x46546C67; // "glTF"
+const uint32_t GLB_CHUNK_JSON = 0x4E4F534A;
+const uint32_t GLB_CHUNK_BIN = 0x004E4942;
+
+struct Buffer {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    std::vector<uint8_t> owned;        // Decoded data: URI
+    std::unique_ptr<MappedFile> file;  // External .bin
+};
+
+struct BufferView {
+    int buffer = -1;
+    size_t byteOffset = 0;
+    size_t byteLength = 0;
+    size_t byteStride = 0; // 0 = tightly packed
+};
+
+struct Accessor {
+    int bufferView = -1;
+    size_t byteOffset = 0;
+    int componentType = 0;
+    bool normalized = false;
+    size_t count = 0;
+    int components = 0;
+    size_t stride = 0; // Effective stride in bytes
+    bool hasBounds = false;
+    glm::vec3 min = glm::vec3(0.0f);
+    glm::vec3 max = glm::vec3(0.0f);
+};
+
+struct Primitive {
+    PrimitiveType mode = PrimitiveType::Triangles;
+    int indices = -1;
+    int position = -1;
+    int color = -1;
+    int normal = -1;
+    glm::vec4 baseColor = glm::vec4(1.0f);
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+};
+
+struct MeshInstances {
+    int mesh = -1;
+    int node = -1;
+    glm::mat4 world = glm::mat4(1.0f);
+    std::vector<glm::mat4> matrices;
+};
+
+inline size_t componentSize(int componentType) {
+    switch (componentType) {
+    case GL_BYTE: case GL_UNSIGNED_BYTE: return 1;
+    case GL_SHORT: case GL_UNSIGNED_SHORT: return 2;
+    case GL_UNSIGNED_INT: case GL_FLOAT: return 4;
+    default: return 0;
+    }
+}
+
+inline int componentCount(const std::string& type) {
+    if (type == "SCALAR") return 1;
+    if (type == "VEC2") return 2;
+    if (type == "VEC3") return 3;
+    if (type == "VEC4") return 4;
+    if (type == "MAT2") return 4;
+    if (type == "MAT3") return 9;
+    if (type == "MAT4") return 16;
+    return 0;
+}
+
+// One component as float, applying normalization rules of the spec
+inline float readComponent(const uint8_t* data, int componentType, bool normalized) {
+    switch (componentType) {
+    case GL_FLOAT: { float v; std::memcpy(&v, data, 4); return v; }
+    case GL_BYTE: { int8_t v = static_cast<int8_t>(*data); return normalized ? std::max(v / 127.0f, -1.0f) : v; }
+    case GL_UNSIGNED_BYTE: return normalized ? *data / 255.0f : *data;
+    case GL_SHORT: { int16_t v; std::memcpy(&v, data, 2); return normalized ? std::max(v / 32767.0f, -1.0f) : v; }
+    case GL_UNSIGNED_SHORT: { uint16_t v; std::memcpy(&v, data, 2); return normalized ? v / 65535.0f : v; }
+    case GL_UNSIGNED_INT: { uint32_t v; std::memcpy(&v, data, 4); return static_cast<float>(v); }
+    default: return 0.0f;
+    }
+}
+
+inline bool base64Decode(const std::string& text, size_t begin, std::vector<uint8_t>& out) {
+    auto value = [](char c) -> int {
+        if (c >= 'A' && c <= 'Z') return c - 'A';
+        if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+        if (c >= '0' && c <= '9') return c - '0' + 52;
+        if (c == '+' || c == '-') return 62;
+        if (c == '/' || c == '_') return 63;
+        return -1;
+    };
+    out.clear();
+    out.reserve((text.size() - begin) * 3 / 4);
+    uint32_t bits = 0;
+    int bitCount = 0;
+    for (size_t i = begin; i < text.size() && text[i] != '='; ++i) {
+        int v = value(text[i]);
+        if (v < 0)
+            return false;
+        bits = (bits << 6) | static_cast<uint32_t>(v);
+        bitCount += 6;
+        if (bitCount >= 8) {
+            bitCount -= 8;
+            out.push_back(static_cast<uint8_t>(bits >> bitCount));
+        }
+    }
+    return true;
+}
+
+inline int hexDigit(char c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+inline std::string percentDecode(const std::string& uri) {
+    std::string out;
+    for (size_t i = 0; i < uri.size(); ++i) {
+        bool escape = uri[i] == '%' && i + 2 < uri.size() && hexDigit(uri[i + 1]) >= 0 && hexDigit(uri[i + 2]) >= 0;
+        if (escape) {
+            out += static_cast<char>(hexDigit(uri[i + 1]) * 16 + hexDigit(uri[i + 2]));
+            i += 2;
+        } else {
+            // Also a '%' that does not start a valid escape, kept as written
+            out += uri[i];
+        }
+    }
+    return out;
+}
+
+inline std::string directoryOf(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+}
+
+// A byte count or offset: 0 when `key` is absent, false unless it is a
+// non-negative integer, so a negative value cannot wrap around as size_t
+inline bool readSize(const JsonValue& object, const char* key, size_t& value) {
+    value = 0;
+    if (!object.has(key))
+        return true;
+    int64_t number = object[key].asInt(-1);
+    if (number < 0)
+        return false;
+    value = static_cast<size_t>(number);
+    return true;
+}
+
+inline glm::mat4 nodeLocalMatrix(const JsonValue& node) {
+    const JsonValue& matrix = node["matrix"];
+    if (matrix.size() == 16) {
+        glm::mat4 result;
+        for (int i = 0; i < 16; ++i)
+            glm::value_ptr(result)[i] = static_cast<float>(matrix[i].asNumber());
+        return result;
+    }
+    glm::vec3 translation(0.0f), scale(1.0f);
+    glm::quat rotation(1.0f, 0.0f, 0.0f, 0.0f);
+    if (node["translation"].size() == 3)
+        translation = glm::vec3(node["translation"][0].asNumber(), node["translation"][1].asNumber(),
+            node["translation"][2].asNumber());
+    if (node["rotation"].size() == 4)
+        rotation = glm::quat(static_cast<float>(node["rotation"][3].asNumber()),
+            static_cast<float>(node["rotation"][0].asNumber()), static_cast<float>(node["rotation"][1].asNumber()),
+            static_cast<float>(node["rotation"][2].asNumber()));
+    if (node["scale"].size() == 3)
+        scale = glm::vec3(node["scale"][0].asNumber(), node["scale"][1].asNumber(), node["scale"][2].asNumber());
+    return glm::translate(glm::mat4(1.0f), translation) * glm::mat4_cast(rotation) * glm::scale(glm::mat4(1.0f), scale);
+}
+
+class Loader {
+public:
+    Loader(JobSystem& jobSystem) : jobs(jobSystem) {}
+
+    bool load(const std::string& path, GltfModel& model, std::string& error) {
+        if (!readDocument(path, error) || !checkExtensions(error) || !loadBuffers(path, error) ||
+            !parseViews(error) || !parseAccessors(error) || !decodeMeshes(error) || !collectInstances(error))
+            return false;
+        upload(model);
+        return true;
+    }
+
+private:
+    bool readDocument(const std::string& path, std::string& error) {
+        std::string json;
+        if (hasExtension(path, ".glb")) {
+            glb = std::make_unique<MappedFile>();
+            if (!glb->open(path)) {
+                error = "cannot open " + path;
+                return false;
+            }
+            const uint8_t* data = glb->bytes();
+            size_t size = glb->byteSize();
+            uint32_t header[3];
+            if (size < 20 || (std::memcpy(header, data, 12), header[0] != GLB_MAGIC) || header[1] != 2) {
+                error = "not a glTF 2.0 binary";
+                return false;
+            }
+            size_t offset = 12;
+            while (offset + 8 <= size) {
+                uint32_t chunk[2];
+                std::memcpy(chunk, data + offset, 8);
+                if (offset + 8 + chunk[0] > size) {
+                    error = "truncated GLB chunk";
+                    return false;
+                }
+                if (chunk[1] == GLB_CHUNK_JSON)
+                    json.assign(reinterpret_cast<const char*>(data + offset + 8), chunk[0]);
+                else if (chunk[1] == GLB_CHUNK_BIN && !glbBin) {
+                    glbBin = data + offset + 8;
+                    glbBinSize = chunk[0];
+                }
+                offset += 8 + ((chunk[0] + 3u) & ~3u);
+            }
+        } else {
+            std::ifstream file(path, std::ios::binary);
+            if (!file) {
+                error = "cannot open " + path;
+                return false;
+            }
+            json.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        if (!parseJson(json.data(), json.data() + json.size(), document, error))
+            return false;
+        if (document["asset"]["version"].asString().compare(0, 1, "2") != 0) {
+            error = "not a glTF 2.0 asset";
+            return false;
+        }
+        return true;
+    }
+
+    bool checkExtensions(std::string& error) {
+        const JsonValue& required = document["extensionsRequired"];
+        for (size_t i = 0; i < required.size(); ++i) {
+            const std::string& name = required[i].asString();
+            if (name != "EXT_mesh_gpu_instancing" && name != "KHR_mesh_quantization") {
+                error = "unsupported required extension " + name;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool loadBuffers(const std::string& path, std::string& error) {
+        const JsonValue& list = document["buffers"];
+        buffers.resize(list.size());
+        std::vector<std::string> errors(list.size());
+        std::string directory = directoryOf(path);
+        jobs.parallelFor("gltf buffers", 0, list.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                Buffer& buffer = buffers[i];
+                const std::string& uri = list[i]["uri"].asString();
+                size_t declared = 0;
+                if (!readSize(list[i], "byteLength", declared)) {
+                    errors[i] = "buffer " + std::to_string(i) + " has a bad byteLength";
+                    continue;
+                }
+                if (uri.empty()) {
+                    // The GLB-stored buffer
+                    buffer.data = glbBin;
+                    buffer.size = glbBin ? glbBinSize : 0;
+                } else if (uri.compare(0, 5, "data:") == 0) {
+                    size_t comma = uri.find(',');
+                    if (comma == std::string::npos || uri.find(";base64") == std::string::npos ||
+                        !base64Decode(uri, comma + 1, buffer.owned)) {
+                        errors[i] = "unsupported data URI in buffer " + std::to_string(i);
+                        continue;
+                    }
+                    buffer.data = buffer.owned.data();
+                    buffer.size = buffer.owned.size();
+                } else {
+                    buffer.file = std::make_unique<MappedFile>();
+                    if (!buffer.file->open(directory + percentDecode(uri))) {
+                        errors[i] = "cannot open buffer " + uri;
+                        continue;
+                    }
+                    buffer.data = buffer.file->bytes();
+                    buffer.size = buffer.file->byteSize();
+                }
+                if (buffer.size < declared)
+                    errors[i] = "buffer " + std::to_string(i) + " is shorter than its byteLength";
+            }
+        });
+        for (const std::string& message : errors) {
+            if (!message.empty()) {
+                error = message;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool parseViews(std::string& error) {
+        const JsonValue& list = document["bufferViews"];
+        views.resize(list.size());
+        for (size_t i = 0; i < list.size(); ++i) {
+            BufferView& view = views[i];
+            int64_t buffer = list[i]["buffer"].asInt(-1);
+            if (!readSize(list[i], "byteOffset", view.byteOffset) || !readSize(list[i], "byteLength", view.byteLength) ||
+                !readSize(list[i], "byteStride", view.byteStride)) {
+                error = "bufferView " + std::to_string(i) + " has a bad byteOffset, byteLength or byteStride";
+                return false;
+            }
+            if (buffer < 0 || buffer >= static_cast<int64_t>(buffers.size()) ||
+                view.byteLength > buffers[buffer].size || view.byteOffset > buffers[buffer].size - view.byteLength) {
+                error = "bufferView " + std::to_string(i) + " is outside its buffer";
+                return false;
+            }
+            view.buffer = static_cast<int>(buffer);
+        }
+        return true;
+    }
+
+    bool parseAccessors(std::string& error) {
+        const JsonValue& list = document["accessors"];
+        accessors.resize(list.size());
+        for (size_t i = 0; i < list.size(); ++i) {
+            const JsonValue& json = list[i];
+            Accessor& accessor = accessors[i];
+            if (json.has("sparse")) {
+                error = "sparse accessors are not supported";
+                return false;
+            }
+            int64_t bufferView = json["bufferView"].asInt(-1);
+            accessor.componentType = static_cast<int>(json["componentType"].asInt());
+            accessor.normalized = json["normalized"].asBool();
+            accessor.components = componentCount(json["type"].asString());
+            if (!readSize(json, "byteOffset", accessor.byteOffset) || !readSize(json, "count", accessor.count)) {
+                error = "accessor " + std::to_string(i) + " has a bad byteOffset or count";
+                return false;
+            }
+            size_t elementSize = componentSize(accessor.componentType) * accessor.components;
+            if (elementSize == 0 || bufferView < 0 || bufferView >= static_cast<int64_t>(views.size())) {
+                error = "accessor " + std::to_string(i) + " has no usable data";
+                return false;
+            }
+            accessor.bufferView = static_cast<int>(bufferView);
+            const BufferView& view = views[accessor.bufferView];
+            accessor.stride = view.byteStride ? view.byteStride : elementSize;
+            // Written so that no term can wrap around, whatever the count
+            if (accessor.count > 0 && (accessor.byteOffset > view.byteLength ||
+                view.byteLength - accessor.byteOffset < elementSize ||
+                accessor.count - 1 > (view.byteLength - accessor.byteOffset - elementSize) / accessor.stride)) {
+                error = "accessor " + std::to_string(i) + " reads past its bufferView";
+                return false;
+            }
+            if (json["min"].size() >= 3 && json["max"].size() >= 3) {
+                accessor.hasBounds = true;
+                for (int c = 0; c < 3; ++c) {
+                    accessor.min[c] = static_cast<float>(json["min"][c].asNumber());
+                    accessor.max[c] = static_cast<float>(json["max"][c].asNumber());
+                }
+            }
+        }
+        return true;
+    }
+
+    const uint8_t* element(const Accessor& accessor, size_t index) const {
+        const BufferView& view = views[accessor.bufferView];
+        return buffers[view.buffer].data + view.byteOffset + accessor.byteOffset + index * accessor.stride;
+    }
+
+    glm::vec4 readVec(const Accessor& accessor, size_t index) const {
+        glm::vec4 value(0.0f, 0.0f, 0.0f, 1.0f);
+        const uint8_t* data = element(accessor, index);
+        size_t size = componentSize(accessor.componentType);
+        for (int c = 0; c < std::min(accessor.components, 4); ++c)
+            value[c] = readComponent(data + c * size, accessor.componentType, accessor.normalized);
+        return value;
+    }
+
+    int attribute(const JsonValue& primitive, const char* name) const {
+        int index = static_cast<int>(primitive["attributes"][name].asInt(-1));
+        return index >= 0 && index < static_cast<int>(accessors.size()) ? index : -1;
+    }
+
+    // Meshes are independent of each other, decode them in parallel
+    bool decodeMeshes(std::string& error) {
+        const JsonValue& list = document["meshes"];
+        meshes.resize(list.size());
+        std::vector<std::string> errors(list.size());
+        jobs.parallelFor("gltf meshes", 0, list.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t m = begin; m < end; ++m) {
+                const JsonValue& primitives = list[m]["primitives"];
+                for (size_t p = 0; p < primitives.size(); ++p) {
+                    const JsonValue& json = primitives[p];
+                    Primitive primitive;
+                    static const PrimitiveType modes[] = { PrimitiveType::Points, PrimitiveType::Lines,
+                        PrimitiveType::LineLoop, PrimitiveType::LineStrip, PrimitiveType::Triangles,
+                        PrimitiveType::TriangleStrip, PrimitiveType::TriangleFan };
+                    int64_t mode = json["mode"].asInt(4);
+                    primitive.mode = modes[mode >= 0 && mode <= 6 ? mode : 4];
+                    primitive.position = attribute(json, "POSITION");
+                    primitive.color = attribute(json, "COLOR_0");
+                    primitive.normal = attribute(json, "NORMAL");
+                    primitive.indices = static_cast<int>(json["indices"].asInt(-1));
+                    if (primitive.position < 0 || accessors[primitive.position].components != 3) {
+                        errors[m] = "mesh " + std::to_string(m) + " has a primitive without VEC3 POSITION";
+                        break;
+                    }
+                    if (primitive.indices >= static_cast<int>(accessors.size()) ||
+                        (primitive.indices >= 0 && (accessors[primitive.indices].components != 1 ||
+                            accessors[primitive.indices].componentType == GL_FLOAT))) {
+                        errors[m] = "mesh " + std::to_string(m) + " has invalid indices";
+                        break;
+                    }
+                    const JsonValue& factor =
+                        document["materials"][static_cast<size_t>(json["material"].asInt(-1))]["pbrMetallicRoughness"]["baseColorFactor"];
+                    if (factor.size() == 4)
+                        primitive.baseColor = glm::vec4(factor[0].asNumber(), factor[1].asNumber(),
+                            factor[2].asNumber(), factor[3].asNumber());
+
+                    // POSITION min/max are mandatory, but scan if an exporter left them out
+                    const Accessor& position = accessors[primitive.position];
+                    if (position.hasBounds) {
+                        primitive.boundsMin = position.min;
+                        primitive.boundsMax = position.max;
+                    } else if (position.count > 0) {
+                        primitive.boundsMin = primitive.boundsMax = glm::vec3(readVec(position, 0));
+                        for (size_t v = 1; v < position.count; ++v) {
+                            glm::vec3 point(readVec(position, v));
+                            primitive.boundsMin = glm::min(primitive.boundsMin, point);
+                            primitive.boundsMax = glm::max(primitive.boundsMax, point);
+                        }
+                    }
+                    meshes[m].push_back(primitive);
+                }
+            }
+        });
+        for (const std::string& message : errors) {
+            if (!message.empty()) {
+                error = message;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void visitNode(int index, const glm::mat4& parent, int depth) {
+        const JsonValue& node = document["nodes"][static_cast<size_t>(index)];
+        if (node.isNull() || depth > 64)
+            return;
+        glm::mat4 world = parent * nodeLocalMatrix(node);
+        int mesh = static_cast<int>(node["mesh"].asInt(-1));
+        if (mesh >= 0 && mesh < static_cast<int>(meshes.size()))
+            instances.push_back({ mesh, index, world, {} });
+        const JsonValue& children = node["children"];
+        for (size_t c = 0; c < children.size(); ++c)
+            visitNode(static_cast<int>(children[c].asInt(-1)), world, depth + 1);
+    }
+
+    bool collectInstances(std::string& error) {
+        glm::mat4 root = glm::rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+        size_t sceneIndex = static_cast<size_t>(document["scene"].asInt(0));
+        const JsonValue& roots = document["scenes"][sceneIndex]["nodes"];
+        if (roots.isNull()) {
+            // No scene: treat every node as a root
+            for (size_t n = 0; n < document["nodes"].size(); ++n)
+                visitNode(static_cast<int>(n), root, 0);
+        } else {
+            for (size_t n = 0; n < roots.size(); ++n)
+                visitNode(static_cast<int>(roots[n].asInt(-1)), root, 0);
+        }
+
+        std::vector<std::string> errors(instances.size());
+        jobs.parallelFor("gltf instances", 0, instances.size(), 16, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                MeshInstances& set = instances[i];
+                const JsonValue& instancing =
+                    document["nodes"][static_cast<size_t>(set.node)]["extensions"]["EXT_mesh_gpu_instancing"]["attributes"];
+                if (instancing.isNull()) {
+                    set.matrices.push_back(set.world);
+                    continue;
+                }
+                int translation = static_cast<int>(instancing["TRANSLATION"].asInt(-1));
+                int rotation = static_cast<int>(instancing["ROTATION"].asInt(-1));
+                int scale = static_cast<int>(instancing["SCALE"].asInt(-1));
+                if (translation >= static_cast<int>(accessors.size()) || rotation >= static_cast<int>(accessors.size())
+                    || scale >= static_cast<int>(accessors.size())) {
+                    errors[i] = "instancing accessor out of range";
+                    continue;
+                }
+                size_t count = 0;
+                for (int a : { translation, rotation, scale }) {
+                    if (a >= 0)
+                        count = count ? std::min(count, accessors[a].count) : accessors[a].count;
+                }
+                set.matrices.resize(count);
+                for (size_t k = 0; k < count; ++k) {
+                    glm::vec3 t = translation >= 0 ? glm::vec3(readVec(accessors[translation], k)) : glm::vec3(0.0f);
+                    glm::vec4 r = rotation >= 0 ? readVec(accessors[rotation], k) : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+                    glm::vec3 s = scale >= 0 ? glm::vec3(readVec(accessors[scale], k)) : glm::vec3(1.0f);
+                    set.matrices[k] = set.world * glm::translate(glm::mat4(1.0f), t) *
+                        glm::mat4_cast(glm::quat(r.w, r.x, r.y, r.z)) * glm::scale(glm::mat4(1.0f), s);
+                }
+            }
+        });
+        for (const std::string& message : errors) {
+            if (!message.empty()) {
+                error = message;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    GLuint viewBuffer(int view, GltfModel& model) {
+        auto found = viewBuffers.find(view);
+        if (found != viewBuffers.end())
+            return found->second;
+        const BufferView& source = views[view];
+        GLuint buffer = createBuffer(source.byteLength, buffers[source.buffer].data + source.byteOffset);
+        model.buffers.push_back(buffer);
+        viewBuffers[view] = buffer;
+        return buffer;
+    }
+
+    // One binding per attribute: the accessor offset goes on the binding, so
+    // it is not limited to the maximum relative offset
+    void addAttribute(VertexArrayBuilder& builder, GLuint location, int accessorIndex, GltfModel& model) {
+        const Accessor& accessor = accessors[accessorIndex];
+        builder.buffer(location, viewBuffer(accessor.bufferView, model), accessor.byteOffset,
+            static_cast<GLsizei>(accessor.stride));
+        builder.attribute(location, location, accessor.components, static_cast<GLenum>(accessor.componentType),
+            accessor.normalized, 0);
+    }
+
+    void upload(GltfModel& model) {
+        bool haveBounds = false;
+        for (const MeshInstances& set : instances) {
+            if (set.matrices.empty())
+                continue;
+            // Per-draw instance matrices, attributes 3..6
+            GLuint instanceBuffer = createBuffer(set.matrices.size() * sizeof(glm::mat4), set.matrices.data());
+            model.buffers.push_back(instanceBuffer);
+
+            for (const Primitive& primitive : meshes[set.mesh]) {
+                VertexArrayBuilder builder;
+                addAttribute(builder, 0, primitive.position, model);
+                if (primitive.color >= 0)
+                    addAttribute(builder, 1, primitive.color, model);
+                if (primitive.normal >= 0)
+                    addAttribute(builder, 2, primitive.normal, model);
+                builder.buffer(3, instanceBuffer, 0, sizeof(glm::mat4), 1).matrixAttribute(3, 3);
+
+                DrawItem draw;
+                draw.primitive = primitive.mode;
+                draw.baseColor = primitive.baseColor;
+                draw.instanceCount = static_cast<uint32_t>(set.matrices.size());
+                if (primitive.indices >= 0) {
+                    const Accessor& indices = accessors[primitive.indices];
+                    builder.indices(viewBuffer(indices.bufferView, model));
+                    draw.indexed = true;
+                    draw.indexType = indices.componentType == GL_UNSIGNED_BYTE ? IndexType::UInt8
+                        : indices.componentType == GL_UNSIGNED_SHORT ? IndexType::UInt16 : IndexType::UInt32;
+                    draw.count = static_cast<uint32_t>(indices.count);
+                    draw.first = static_cast<uint32_t>(indices.byteOffset / componentSize(indices.componentType));
+                } else {
+                    draw.indexed = false;
+                    draw.count = static_cast<uint32_t>(accessors[primitive.position].count);
+                }
+                draw.vertexArray = builder.create();
+                model.vertexArrays.push_back(draw.vertexArray);
+                model.draws.push_back(draw);
+
+                for (const glm::mat4& matrix : set.matrices) {
+                    for (int corner = 0; corner < 8; ++corner) {
+                        glm::vec3 local((corner & 1) ? primitive.boundsMax.x : primitive.boundsMin.x,
+                            (corner & 2) ? primitive.boundsMax.y : primitive.boundsMin.y,
+                            (corner & 4) ? primitive.boundsMax.z : primitive.boundsMin.z);
+                        glm::vec3 world(matrix * glm::vec4(local, 1.0f));
+                        model.boundsMin = haveBounds ? glm::min(model.boundsMin, world) : world;
+                        model.boundsMax = haveBounds ? glm::max(model.boundsMax, world) : world;
+                        haveBounds = true;
+                    }
+                }
+            }
+        }
+        // Primitives without COLOR_0 read the generic attribute: white
+        glVertexAttrib4f(1, 1.0f, 1.0f, 1.0f, 1.0f);
+    }
+
+    JobSystem& jobs;
+    JsonValue document;
+    std::unique_ptr<MappedFile> glb;
+    const uint8_t* glbBin = nullptr;
+    size_t glbBinSize = 0;
+    std::vector<Buffer> buffers;
+    std::vector<BufferView> views;
+    std::vector<Accessor> accessors;
+    std::vector<std::vector<Primitive>> meshes;
+    std::vector<MeshInstances> instances;
+    std::map<int, GLuint> viewBuffers;
+};
+
+} // namespace gltfdetail
+
+inline bool loadGltf(const std::string& path, JobSystem& jobs, GltfModel& model, std::string& error) {
+    gltfdetail::Loader loader(jobs);
+    return loader.load(path, model, error);
+}
+
+inline void destroyGltf(GltfModel& model) {
+    if (!model.vertexArrays.empty())
+        glDeleteVertexArrays(static_cast<GLsizei>(model.vertexArrays.size()), model.vertexArrays.data());
+    if (!model.buffers.empty())
+        glDeleteBuffers(static_cast<GLsizei>(model.buffers.size()), model.buffers.data());
+    model = GltfModel();
+}
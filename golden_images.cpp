@@ -0,0 +1,225 @@
+// Golden-image runner: renders fixed scenes with A2_Comp371 and compares the
+// last frame of each against a stored reference (see image_compare.h).
+//
+// Usage: golden_images [--update] [--jobs N] [--exe PATH] [--scenes FILE] [--out DIR]
+//                      [--tolerance N] [--threshold X] [SCENE...]
+//   --update     write the rendered frames as the new references instead of comparing
+//   --jobs N     scenes rendered at once, each in its own process (default: hardware threads)
+//   --exe PATH   the renderer (default A2_Comp371 in the working directory)
+//   --scenes     scene list, default golden/scenes.txt; one scene per line:
+//                  NAME FRAMES [A2_Comp371 options...]
+//                references live next to it as NAME.png
+//   --out DIR    renders, logs and diff images (default golden/out)
+//   --tolerance  channel difference (0-255) a pixel may have, default 2
+//   --threshold  perceptual difference (0-1) a pixel may have, default 0.01
+//   SCENE...     only run these scenes
+// Each scene runs headless for FRAMES fixed-step frames and captures the
+// last one. A failing scene gets OUT/NAME_diff.png: failing pixels in red,
+// pixels within the limits in yellow. Exits with 1 when any scene fails.
+
+#define GLM_FORCE_INTRINSICS
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "image_compare.h"
+
+namespace fs = std::filesystem;
+
+struct Scene {
+    std::string name;
+    int frames = 0;
+    std::string arguments;
+};
+
+struct SceneResult {
+    bool passed = false;
+    std::string message;
+};
+
+struct RunOptions {
+    bool update = false;
+    unsigned int jobs = 0;
+#ifdef _WIN32
+    std::string executable = "A2_Comp371.exe";
+#else
+    std::string executable = "./A2_Comp371";
+#endif
+    std::string scenesPath = "golden/scenes.txt";
+    std::string outputDir = "golden/out";
+    uint32_t tolerance = 2;
+    float threshold = 0.01f;
+    std::vector<std::string> only;
+};
+
+bool loadScenes(const std::string& path, std::vector<Scene>& scenes) {
+    std::ifstream file(path);
+    if (!file)
+        return false;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        std::istringstream fields(line);
+        Scene scene;
+        if (!(fields >> scene.name) || scene.name[0] == '#')
+            continue;
+        if (!(fields >> scene.frames) || scene.frames <= 0) {
+            std::cerr << path << ": scene " << scene.name << " needs a frame count" << std::endl;
+            continue;
+        }
+        std::getline(fields, scene.arguments);
+        scenes.push_back(scene);
+    }
+    return true;
+}
+
+std::string quoted(const std::string& path) {
+    return "\"" + path + "\"";
+}
+
+SceneResult runScene(const Scene& scene, const RunOptions& options, const fs::path& referenceDir) {
+    SceneResult result;
+    fs::path prefix = fs::path(options.outputDir) / scene.name;
+    char number[24];
+    std::snprintf(number, sizeof(number), "_%06d.png", scene.frames - 1);
+    fs::path rendered = prefix.string() + number;
+    fs::path reference = referenceDir / (scene.name + ".png");
+    std::error_code ignored;
+    fs::remove(rendered, ignored);
+
+    // Capture only the last frame; --frames makes the run fixed-step
+    std::string command = quoted(options.executable) + " --headless --frames " + std::to_string(scene.frames)
+        + " --capture " + quoted(prefix.string()) + " --capture-every " + std::to_string(scene.frames) + " "
+        + scene.arguments + " > " + quoted(prefix.string() + ".log") + " 2>&1";
+#ifdef _WIN32
+    command = "\"" + command + "\""; // cmd /c strips the outer quotes
+#endif
+    int status = std::system(command.c_str());
+    if (status != 0 || !fs::exists(rendered)) {
+        result.message = "render failed (exit status " + std::to_string(status) + "), see "
+            + prefix.string() + ".log";
+        return result;
+    }
+
+    if (options.update) {
+        fs::copy_file(rendered, reference, fs::copy_options::overwrite_existing, ignored);
+        result.passed = !ignored;
+        result.message = ignored ? "cannot write " + reference.string() : "updated " + reference.string();
+        return result;
+    }
+
+    uint32_t width = 0, height = 0, referenceWidth = 0, referenceHeight = 0;
+    std::vector<uint8_t> image, expected;
+    std::string error;
+    if (!fs::exists(reference)) {
+        result.message = "no reference " + reference.string() + ", run with --update";
+        return result;
+    }
+    if (!decodePng(reference.string(), referenceWidth, referenceHeight, expected, error)
+        || !decodePng(rendered.string(), width, height, image, error)) {
+        result.message = error;
+        return result;
+    }
+    if (width != referenceWidth || height != referenceHeight) {
+        result.message = "size " + std::to_string(width) + "x" + std::to_string(height) + ", reference "
+            + std::to_string(referenceWidth) + "x" + std::to_string(referenceHeight);
+        return result;
+    }
+
+    std::vector<uint8_t> diffImage;
+    ImageDiff diff = compareImages(expected.data(), image.data(), width, height, options.tolerance,
+        options.threshold, &diffImage);
+    std::ostringstream message;
+    message << diff.failing << " failing, " << diff.differing << " differing pixels, max channel delta "
+        << diff.maxChannelDelta << ", perceptual max " << std::setprecision(3) << diff.maxPerceptual << " mean "
+        << diff.meanPerceptual;
+    result.passed = diff.failing == 0;
+    fs::path diffPath = prefix.string() + "_diff.png";
+    if (result.passed)
+        fs::remove(diffPath, ignored);
+    else if (writePng(diffPath.string(), width, height, diffImage))
+        message << ", see " << diffPath.string();
+    result.message = message.str();
+    return result;
+}
+
+int main(int argc, char** argv) {
+    RunOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--update")
+            options.update = true;
+        else if (arg == "--jobs" && hasValue)
+            options.jobs = static_cast<unsigned int>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--exe" && hasValue)
+            options.executable = argv[++i];
+        else if (arg == "--scenes" && hasValue)
+            options.scenesPath = argv[++i];
+        else if (arg == "--out" && hasValue)
+            options.outputDir = argv[++i];
+        else if (arg == "--tolerance" && hasValue)
+            options.tolerance = static_cast<uint32_t>(std::min(255, std::max(0, std::atoi(argv[++i]))));
+        else if (arg == "--threshold" && hasValue)
+            options.threshold = std::max(0.0f, static_cast<float>(std::atof(argv[++i])));
+        else if (arg.compare(0, 2, "--") == 0)
+            std::cerr << "Unknown option: " << arg << std::endl;
+        else
+            options.only.push_back(arg);
+    }
+
+    std::vector<Scene> scenes;
+    if (!loadScenes(options.scenesPath, scenes)) {
+        std::cerr << "Cannot read " << options.scenesPath << std::endl;
+        return 2;
+    }
+    if (!options.only.empty()) {
+        scenes.erase(std::remove_if(scenes.begin(), scenes.end(), [&](const Scene& scene) {
+            return std::find(options.only.begin(), options.only.end(), scene.name) == options.only.end();
+        }), scenes.end());
+    }
+    std::error_code error;
+    fs::create_directories(options.outputDir, error);
+    if (error) {
+        std::cerr << "Cannot create " << options.outputDir << ": " << error.message() << std::endl;
+        return 2;
+    }
+    fs::path referenceDir = fs::path(options.scenesPath).parent_path();
+
+    // Each renderer is its own process with its own context, so scenes run
+    // side by side; the threads here only start them and compare the results
+    unsigned int jobs = options.jobs ? options.jobs : std::max(1u, std::thread::hardware_concurrency());
+    jobs = std::min<unsigned int>(jobs, static_cast<unsigned int>(std::max<size_t>(scenes.size(), 1)));
+    std::vector<SceneResult> results(scenes.size());
+    std::atomic<size_t> next{ 0 };
+    std::mutex outputMutex;
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < jobs; ++i) {
+        workers.emplace_back([&]() {
+            for (size_t index = next++; index < scenes.size(); index = next++) {
+                results[index] = runScene(scenes[index], options, referenceDir);
+                std::lock_guard<std::mutex> lock(outputMutex);
+                std::cout << (results[index].passed ? "PASS " : "FAIL ") << scenes[index].name << ": "
+                    << results[index].message << std::endl;
+            }
+        });
+    }
+    for (std::thread& worker : workers)
+        worker.join();
+
+    size_t failed = static_cast<size_t>(std::count_if(results.begin(), results.end(),
+        [](const SceneResult& result) { return !result.passed; }));
+    std::cout << scenes.size() - failed << "/" << scenes.size() << " scenes "
+        << (options.update ? "updated" : "passed") << std::endl;
+    return failed == 0 ? 0 : 1;
+}
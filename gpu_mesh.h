@@ -0,0 +1,108 @@
+#pragma once
+
+// GPU copies of meshes: one vertex array with its vertex and index buffers,
+// created through gl_resources.h (immutable storage, direct state access
+// where available).
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "gl_resources.h"
+#include "mesh.h"
+#include "mesh_format.h"
+#include "mesh_optimize.h"
+#include "vertex_quantize.h"
+
+struct GpuMesh {
+    GLuint vertexArray = 0;
+    GLuint vertexBuffer = 0;
+    GLuint indexBuffer = 0;
+    VertexFormat vertexFormat = VertexFormat::PositionColorF32;
+    GLsizei vertexStride = 0;
+    GLenum indexType = GL_UNSIGNED_INT;
+    GLsizei indexCount = 0;
+    std::vector<MeshLod> lods;
+    glm::vec3 boundsCenter = glm::vec3(0.0f);
+    float boundsRadius = 0.0f;
+    glm::mat4 positionDecode = glm::mat4(1.0f); // Stored position -> mesh space
+};
+
+// Attributes 0-2 of `format`, read from buffer binding `binding`
+inline void addVertexFormat(VertexArrayBuilder& builder, VertexFormat format, GLuint binding) {
+    switch (format) {
+    case VertexFormat::PositionColorF32:
+        builder.attribute(0, binding, 3, GL_FLOAT, false, offsetof(Vertex, position));
+        builder.attribute(1, binding, 3, GL_FLOAT, false, offsetof(Vertex, color));
+        break;
+    case VertexFormat::QuantizedSnorm16:
+    case VertexFormat::QuantizedHalf:
+        if (format == VertexFormat::QuantizedSnorm16)
+            builder.attribute(0, binding, 4, GL_SHORT, true, offsetof(QuantizedVertex, position));
+        else
+            builder.attribute(0, binding, 4, GL_HALF_FLOAT, false, offsetof(QuantizedVertex, position));
+        builder.attribute(1, binding, 4, GL_UNSIGNED_BYTE, true, offsetof(QuantizedVertex, color));
+        builder.attribute(2, binding, 2, GL_SHORT, true, offsetof(QuantizedVertex, normal));
+        break;
+    }
+}
+
+// Vertex array reading `mesh`'s buffers through binding 0; callers may add
+// more bindings (per-instance data) before create()
+inline VertexArrayBuilder meshVertexArray(const GpuMesh& mesh) {
+    VertexArrayBuilder builder;
+    builder.buffer(0, mesh.vertexBuffer, 0, mesh.vertexStride).indices(mesh.indexBuffer);
+    addVertexFormat(builder, mesh.vertexFormat, 0);
+    return builder;
+}
+
+inline GpuMesh uploadMesh(VertexFormat format, GLsizei stride, const void* vertexData, size_t vertexBytes,
+    const void* indexData, uint32_t indexSize, size_t indexCount, const std::vector<MeshLod>& lods,
+    const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    GpuMesh mesh;
+    mesh.vertexBuffer = createBuffer(vertexBytes, vertexData);
+    mesh.indexBuffer = createBuffer(indexCount * indexSize, indexData);
+    mesh.vertexFormat = format;
+    mesh.vertexStride = stride;
+    mesh.vertexArray = meshVertexArray(mesh).create();
+    mesh.indexType = indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    mesh.indexCount = static_cast<GLsizei>(indexCount);
+    mesh.lods = lods;
+    if (mesh.lods.empty())
+        mesh.lods.push_back({ 0, static_cast<uint32_t>(indexCount), 0.0f });
+    boundingSphere(boundsMin, boundsMax, mesh.boundsCenter, mesh.boundsRadius);
+    mesh.positionDecode = positionDecodeMatrix(format, boundsMin, boundsMax);
+    return mesh;
+}
+
+inline GpuMesh uploadMesh(const MeshData& data) {
+    if (fitsIndex16(data.vertices.size())) {
+        std::vector<uint16_t> indices = narrowIndices(data.indices);
+        return uploadMesh(VertexFormat::PositionColorF32, sizeof(Vertex), data.vertices.data(),
+            data.vertices.size() * sizeof(Vertex), indices.data(), sizeof(uint16_t), indices.size(),
+            data.lods, data.boundsMin, data.boundsMax);
+    }
+    return uploadMesh(VertexFormat::PositionColorF32, sizeof(Vertex), data.vertices.data(),
+        data.vertices.size() * sizeof(Vertex), data.indices.data(), sizeof(uint32_t), data.indices.size(),
+        data.lods, data.boundsMin, data.boundsMax);
+}
+
+// Upload straight from a mapped .pmesh file
+inline GpuMesh uploadMeshFile(const MeshFileView& file) {
+    const MeshFileHeader& header = *file.header;
+    std::vector<MeshLod> lods;
+    for (uint32_t i = 0; i < header.lodCount; ++i)
+        lods.push_back({ file.lods[i].firstIndex, file.lods[i].indexCount, file.lods[i].maxError });
+    glm::vec3 boundsMin(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    glm::vec3 boundsMax(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+    return uploadMesh(static_cast<VertexFormat>(header.vertexFormat), static_cast<GLsizei>(header.vertexStride),
+        file.vertexData, file.vertexBytes, file.indexData, header.indexSize, header.indexCount, lods,
+        boundsMin, boundsMax);
+}
+
+inline void destroyMesh(GpuMesh& mesh) {
+    glDeleteVertexArrays(1, &mesh.vertexArray);
+    glDeleteBuffers(1, &mesh.vertexBuffer);
+    glDeleteBuffers(1, &mesh.indexBuffer);
+    mesh = GpuMesh();
+}
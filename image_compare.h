@@ -0,0 +1,409 @@
+#pragma once
+
+// Image comparison for the golden-image runner (golden_images.cpp): PNG
+// decoding, a per-pixel tolerance test, a perceptual delta and diff images.
+//
+// Most pixels of a rendering that did not change are within the tolerance,
+// so the tolerance test runs on SSE2 four pixels at a time and finds the
+// pixels outside it. Only those get the perceptual delta: the YIQ color
+// distance of Kotsarenko and Ramos ("Measuring perceived color difference
+// using YIQ NTSC transmission color space in mobile applications"), divided
+// by its largest possible value so it stays within 0 to 1 (black against
+// white is about 0.93). A pixel fails when it is outside the channel
+// tolerance and its perceptual delta is above the threshold, so dithering
+// noise and invisible rounding changes do not fail a scene.
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "frame_capture.h"
+
+namespace imagedetail {
+
+// Decoder for zlib streams (RFC 1950/1951): stored, fixed and dynamic
+// Huffman blocks. Canonical codes are decoded a bit at a time, like zlib's
+// puff; reference images are small enough for that.
+class Inflater {
+public:
+    Inflater(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+    bool inflate(std::vector<uint8_t>& out) {
+        if (size < 2 || (data[0] & 0x0F) != 8 || ((data[0] << 8) | data[1]) % 31 != 0)
+            return false;
+        position = 2;
+        bool last = false;
+        while (!last) {
+            last = bits(1) == 1;
+            uint32_t type = bits(2);
+            bool ok = type == 0 ? stored(out) : type == 1 ? fixed(out) : type == 2 ? dynamic(out) : false;
+            if (!ok || overrun)
+                return false;
+        }
+        return true;
+    }
+
+private:
+    struct Huffman {
+        uint16_t counts[16] = {};
+        uint16_t symbols[288] = {};
+    };
+
+    uint32_t bits(int count) {
+        while (bitCount < count) {
+            if (position >= size) {
+                overrun = true;
+                return 0;
+            }
+            bitBuffer |= static_cast<uint32_t>(data[position++]) << bitCount;
+            bitCount += 8;
+        }
+        uint32_t value = bitBuffer & ((1u << count) - 1);
+        bitBuffer >>= count;
+        bitCount -= count;
+        return value;
+    }
+
+    static bool build(Huffman& huffman, const uint8_t* lengths, int count) {
+        for (int i = 0; i < count; ++i)
+            ++huffman.counts[lengths[i]];
+        huffman.counts[0] = 0;
+        uint16_t offsets[16] = {};
+        for (int length = 1; length < 15; ++length)
+            offsets[length + 1] = offsets[length] + huffman.counts[length];
+        for (int i = 0; i < count; ++i) {
+            if (lengths[i] != 0)
+                huffman.symbols[offsets[lengths[i]]++] = static_cast<uint16_t>(i);
+        }
+        return true;
+    }
+
+    int decode(const Huffman& huffman) {
+        int code = 0, first = 0, index = 0;
+        for (int length = 1; length < 16; ++length) {
+            code |= static_cast<int>(bits(1));
+            int count = huffman.counts[length];
+            if (code - count < first)
+                return huffman.symbols[index + (code - first)];
+            index += count;
+            first = (first + count) << 1;
+            code <<= 1;
+        }
+        return -1;
+    }
+
+    bool stored(std::vector<uint8_t>& out) {
+        bitBuffer = 0;
+        bitCount = 0;
+        if (position + 4 > size)
+            return false;
+        uint32_t length = data[position] | (data[position + 1] << 8);
+        uint32_t check = data[position + 2] | (data[position + 3] << 8);
+        position += 4;
+        if ((length ^ 0xFFFF) != check || position + length > size)
+            return false;
+        out.insert(out.end(), data + position, data + position + length);
+        position += length;
+        return true;
+    }
+
+    bool codes(std::vector<uint8_t>& out, const Huffman& literals, const Huffman& distances) {
+        static const uint16_t lengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51,
+            59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        static const uint8_t lengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4,
+            4, 5, 5, 5, 5, 0 };
+        static const uint16_t distanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257,
+            385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+        static const uint8_t distanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9,
+            10, 10, 11, 11, 12, 12, 13, 13 };
+        for (;;) {
+            int symbol = decode(literals);
+            if (symbol < 0 || overrun)
+                return false;
+            if (symbol < 256) {
+                out.push_back(static_cast<uint8_t>(symbol));
+                continue;
+            }
+            if (symbol == 256)
+                return true;
+            symbol -= 257;
+            if (symbol >= 29)
+                return false;
+            size_t length = lengthBase[symbol] + bits(lengthExtra[symbol]);
+            int distanceSymbol = decode(distances);
+            if (distanceSymbol < 0 || distanceSymbol >= 30)
+                return false;
+            size_t distance = distanceBase[distanceSymbol] + bits(distanceExtra[distanceSymbol]);
+            if (distance > out.size())
+                return false;
+            // Byte by byte: the match may overlap what it produces
+            for (size_t i = 0; i < length; ++i)
+                out.push_back(out[out.size() - distance]);
+        }
+    }
+
+    bool fixed(std::vector<uint8_t>& out) {
+        uint8_t lengths[288];
+        for (int i = 0; i < 288; ++i)
+            lengths[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+        Huffman literals, distances;
+        build(literals, lengths, 288);
+        for (int i = 0; i < 30; ++i)
+            lengths[i] = 5;
+        build(distances, lengths, 30);
+        return codes(out, literals, distances);
+    }
+
+    bool dynamic(std::vector<uint8_t>& out) {
+        static const uint8_t order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+        int literalCount = static_cast<int>(bits(5)) + 257;
+        int distanceCount = static_cast<int>(bits(5)) + 1;
+        int codeCount = static_cast<int>(bits(4)) + 4;
+        if (literalCount > 286 || distanceCount > 30)
+            return false;
+        uint8_t lengths[320] = {};
+        for (int i = 0; i < codeCount; ++i)
+            lengths[order[i]] = static_cast<uint8_t>(bits(3));
+        Huffman lengthCode;
+        build(lengthCode, lengths, 19);
+
+        int index = 0;
+        while (index < literalCount + distanceCount) {
+            int symbol = decode(lengthCode);
+            if (symbol < 0 || overrun)
+                return false;
+            if (symbol < 16) {
+                lengths[index++] = static_cast<uint8_t>(symbol);
+                continue;
+            }
+            uint8_t repeated = 0;
+            int repeat;
+            if (symbol == 16) {
+                if (index == 0)
+                    return false;
+                repeated = lengths[index - 1];
+                repeat = 3 + static_cast<int>(bits(2));
+            } else if (symbol == 17) {
+                repeat = 3 + static_cast<int>(bits(3));
+            } else {
+                repeat = 11 + static_cast<int>(bits(7));
+            }
+            if (index + repeat > literalCount + distanceCount)
+                return false;
+            while (repeat-- > 0)
+                lengths[index++] = repeated;
+        }
+        Huffman literals, distances;
+        build(literals, lengths, literalCount);
+        build(distances, lengths + literalCount, distanceCount);
+        return codes(out, literals, distances);
+    }
+
+    const uint8_t* data;
+    size_t size;
+    size_t position = 0;
+    uint32_t bitBuffer = 0;
+    int bitCount = 0;
+    bool overrun = false;
+};
+
+inline uint32_t readBigEndian(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+inline int paeth(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+    return pa <= pb && pa <= pc ? a : pb <= pc ? b : c;
+}
+
+inline uint32_t channelDelta(const uint8_t* a, const uint8_t* b) {
+    uint32_t delta = 0;
+    for (int c = 0; c < 3; ++c)
+        delta = std::max<uint32_t>(delta, static_cast<uint32_t>(std::abs(a[c] - b[c])));
+    return delta;
+}
+
+// Perceived difference of two colors, 0 to 1; 35215 is the largest YIQ distance
+inline float perceptualDelta(const uint8_t* a, const uint8_t* b) {
+    float dr = static_cast<float>(a[0]) - b[0];
+    float dg = static_cast<float>(a[1]) - b[1];
+    float db = static_cast<float>(a[2]) - b[2];
+    float y = dr * 0.29889531f + dg * 0.58662247f + db * 0.11448223f;
+    float i = dr * 0.59597799f - dg * 0.27417610f - db * 0.32180189f;
+    float q = dr * 0.21147017f - dg * 0.52261711f + db * 0.31114694f;
+    return (0.5053f * y * y + 0.299f * i * i + 0.1957f * q * q) / 35215.0f;
+}
+
+} // namespace imagedetail
+
+// Top-down RGBA8 pixels of an 8-bit RGB or RGBA, non-interlaced PNG
+inline bool decodePng(const std::string& path, uint32_t& width, uint32_t& height, std::vector<uint8_t>& pixels,
+    std::string& error) {
+    using namespace imagedetail;
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8_t> png((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    if (png.size() < 8 || !std::equal(signature, signature + 8, png.begin())) {
+        error = "not a PNG file";
+        return false;
+    }
+    std::vector<uint8_t> compressed;
+    int channels = 0;
+    for (size_t offset = 8; offset + 12 <= png.size();) {
+        uint32_t length = readBigEndian(&png[offset]);
+        if (offset + 12 + length > png.size())
+            break;
+        std::string type(png.begin() + offset + 4, png.begin() + offset + 8);
+        const uint8_t* body = &png[offset + 8];
+        if (type == "IHDR" && length >= 13) {
+            width = readBigEndian(body);
+            height = readBigEndian(body + 4);
+            if (body[8] != 8 || (body[9] != 2 && body[9] != 6) || body[12] != 0) {
+                error = "only 8-bit RGB and RGBA PNGs without interlacing are supported";
+                return false;
+            }
+            channels = body[9] == 6 ? 4 : 3;
+        } else if (type == "IDAT") {
+            compressed.insert(compressed.end(), body, body + length);
+        } else if (type == "IEND") {
+            break;
+        }
+        offset += 12 + length;
+    }
+    std::vector<uint8_t> filtered;
+    if (channels == 0 || !Inflater(compressed.data(), compressed.size()).inflate(filtered)) {
+        error = "corrupt PNG data";
+        return false;
+    }
+    size_t rowBytes = static_cast<size_t>(width) * channels;
+    if (filtered.size() < (rowBytes + 1) * height) {
+        error = "truncated PNG data";
+        return false;
+    }
+
+    // Undo the row filters in place, then expand to RGBA
+    std::vector<uint8_t> previous(rowBytes, 0);
+    pixels.resize(static_cast<size_t>(width) * height * 4);
+    for (uint32_t y = 0; y < height; ++y) {
+        uint8_t filter = filtered[y * (rowBytes + 1)];
+        uint8_t* row = &filtered[y * (rowBytes + 1) + 1];
+        for (size_t x = 0; x < rowBytes; ++x) {
+            int left = x >= static_cast<size_t>(channels) ? row[x - channels] : 0;
+            int up = previous[x];
+            int upLeft = x >= static_cast<size_t>(channels) ? previous[x - channels] : 0;
+            int predicted = filter == 1 ? left : filter == 2 ? up : filter == 3 ? (left + up) / 2
+                : filter == 4 ? paeth(left, up, upLeft) : 0;
+            row[x] = static_cast<uint8_t>(row[x] + predicted);
+        }
+        std::copy(row, row + rowBytes, previous.begin());
+        for (uint32_t x = 0; x < width; ++x) {
+            uint8_t* out = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+            for (int c = 0; c < 3; ++c)
+                out[c] = row[x * channels + c];
+            out[3] = channels == 4 ? row[x * channels + 3] : 255;
+        }
+    }
+    return true;
+}
+
+struct ImageDiff {
+    uint64_t differing = 0;       // Pixels not bit-identical (alpha ignored)
+    uint64_t failing = 0;         // Outside the tolerance and above the perceptual threshold
+    uint32_t maxChannelDelta = 0;
+    float maxPerceptual = 0.0f;   // Perceptual deltas of the pixels outside the tolerance,
+    float meanPerceptual = 0.0f;  // the mean taken over all pixels
+};
+
+// Compare two top-down RGBA8 images of the same size. A pixel fails when a
+// color channel differs by more than `tolerance` and the perceptual delta is
+// above `threshold`. `diff`, if not null, receives an RGBA8 diff image when
+// any pixel fails, and is cleared otherwise: the reference faded to gray,
+// differing pixels in yellow, failing ones in red.
+inline ImageDiff compareImages(const uint8_t* reference, const uint8_t* image, uint32_t width, uint32_t height,
+    uint32_t tolerance, float threshold, std::vector<uint8_t>* diff = nullptr) {
+    ImageDiff result;
+    size_t count = static_cast<size_t>(width) * height;
+    double perceptualSum = 0.0;
+    auto outsideTolerance = [&](size_t p) {
+        float perceptual = imagedetail::perceptualDelta(reference + p * 4, image + p * 4);
+        result.failing += perceptual > threshold ? 1 : 0;
+        result.maxPerceptual = std::max(result.maxPerceptual, perceptual);
+        perceptualSum += perceptual;
+    };
+
+    size_t p = 0;
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    // Four pixels per step; only pixels outside the tolerance leave the SIMD path
+    const __m128i colorMask = _mm_set1_epi32(0x00FFFFFF);
+    const __m128i limit = _mm_set1_epi8(static_cast<char>(std::min<uint32_t>(tolerance, 255)));
+    const __m128i zero = _mm_setzero_si128();
+    __m128i maxDelta = zero;
+    for (; p + 4 <= count; p += 4) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(reference + p * 4));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(image + p * 4));
+        __m128i delta = _mm_and_si128(_mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a)), colorMask);
+        maxDelta = _mm_max_epu8(maxDelta, delta);
+        int same = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(delta, zero)));
+        if (same == 0xF)
+            continue;
+        result.differing += 4 - ((same & 1) + ((same >> 1) & 1) + ((same >> 2) & 1) + (same >> 3));
+        __m128i excess = _mm_subs_epu8(delta, limit);
+        int outside = ~_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(excess, zero))) & 0xF;
+        for (size_t k = 0; outside; ++k, outside >>= 1) {
+            if (outside & 1)
+                outsideTolerance(p + k);
+        }
+    }
+    alignas(16) uint8_t lanes[16];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), maxDelta);
+    result.maxChannelDelta = *std::max_element(lanes, lanes + 16);
+#endif
+    for (; p < count; ++p) {
+        uint32_t delta = imagedetail::channelDelta(reference + p * 4, image + p * 4);
+        if (delta == 0)
+            continue;
+        ++result.differing;
+        result.maxChannelDelta = std::max(result.maxChannelDelta, delta);
+        if (delta > tolerance)
+            outsideTolerance(p);
+    }
+    result.meanPerceptual = count > 0 ? static_cast<float>(perceptualSum / count) : 0.0f;
+
+    if (!diff)
+        return result;
+    if (result.failing == 0) {
+        diff->clear();
+        return result;
+    }
+    // Only failing comparisons get here, so a second, scalar pass is fine
+    diff->resize(count * 4);
+    for (size_t q = 0; q < count; ++q) {
+        const uint8_t* a = reference + q * 4;
+        const uint8_t* b = image + q * 4;
+        uint8_t* out = diff->data() + q * 4;
+        uint32_t delta = imagedetail::channelDelta(a, b);
+        if (delta == 0) {
+            uint8_t gray = static_cast<uint8_t>(255 - (255 - (a[0] * 77 + a[1] * 150 + a[2] * 29) / 256) / 8);
+            out[0] = out[1] = out[2] = gray;
+        } else {
+            bool failing = delta > tolerance && imagedetail::perceptualDelta(a, b) > threshold;
+            out[0] = 255;
+            out[1] = failing ? 0 : 200;
+            out[2] = 0;
+        }
+        out[3] = 255;
+    }
+    return result;
+}
+
+inline bool writePng(const std::string& path, uint32_t width, uint32_t height, const std::vector<uint8_t>& pixels) {
+    std::vector<uint8_t> png = encodePng(width, height, pixels.data(), false);
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+// Keyboard input recording and deterministic replay.
+//
+// The simulation advances one tick per frame. Key events are stamped with the
+// tick that first sees them, so replaying a file feeds processInput exactly
+// the same key states on the same ticks regardless of how fast frames render.
+//
+// File layout (little endian):
+//   char[8]  magic "PYRINPUT"
+//   uint32   version (1)
+//   uint32   tickCount: ticks the session lasted, replay stops there
+//   uint32   eventCount
+//   eventCount x { uint64 timeMicros, uint32 tick, uint16 key, uint8 action, uint8 reserved }
+
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+struct InputEvent {
+    uint64_t timeMicros; // Since recording started
+    uint32_t tick;
+    uint16_t key;        // GLFW_KEY_*
+    uint8_t action;      // GLFW_PRESS or GLFW_RELEASE
+    uint8_t reserved;
+};
+
+// Which keys are held at the current tick
+class InputState {
+public:
+    static const int KEY_COUNT = 512; // > GLFW_KEY_LAST
+
+    void set(int key, bool down) {
+        if (key >= 0 && key < KEY_COUNT)
+            keys.set(static_cast<size_t>(key), down);
+    }
+
+    bool isDown(int key) const {
+        return key >= 0 && key < KEY_COUNT && keys.test(static_cast<size_t>(key));
+    }
+
+    bool anyDown() const { return keys.any(); }
+
+private:
+    std::bitset<KEY_COUNT> keys;
+};
+
+namespace inputfile {
+const char MAGIC[8] = { 'P', 'Y', 'R', 'I', 'N', 'P', 'U', 'T' };
+const uint32_t VERSION = 1;
+const size_t EVENT_BYTES = 16;
+
+inline void put(std::vector<uint8_t>& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i)
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+inline uint64_t get(const uint8_t* data, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i)
+        value |= static_cast<uint64_t>(data[i]) << (8 * i);
+    return value;
+}
+}
+
+class InputRecorder {
+public:
+    void record(uint32_t tick, int key, int action, uint64_t timeMicros) {
+        events.push_back({ timeMicros, tick, static_cast<uint16_t>(key), static_cast<uint8_t>(action), 0 });
+    }
+
+    bool save(const std::string& path, uint32_t tickCount) const {
+        std::vector<uint8_t> bytes(inputfile::MAGIC, inputfile::MAGIC + 8);
+        inputfile::put(bytes, inputfile::VERSION, 4);
+        inputfile::put(bytes, tickCount, 4);
+        inputfile::put(bytes, events.size(), 4);
+        for (const InputEvent& event : events) {
+            inputfile::put(bytes, event.timeMicros, 8);
+            inputfile::put(bytes, event.tick, 4);
+            inputfile::put(bytes, event.key, 2);
+            inputfile::put(bytes, event.action, 1);
+            inputfile::put(bytes, 0, 1);
+        }
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return static_cast<bool>(file);
+    }
+
+    size_t eventCount() const { return events.size(); }
+
+private:
+    std::vector<InputEvent> events;
+};
+
+class InputReplayer {
+public:
+    bool load(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        const size_t headerBytes = 20;
+        if (bytes.size() < headerBytes || std::memcmp(bytes.data(), inputfile::MAGIC, 8) != 0 ||
+            inputfile::get(&bytes[8], 4) != inputfile::VERSION)
+            return false;
+        tickCount = static_cast<uint32_t>(inputfile::get(&bytes[12], 4));
+        size_t eventCount = static_cast<size_t>(inputfile::get(&bytes[16], 4));
+        if (bytes.size() < headerBytes + eventCount * inputfile::EVENT_BYTES)
+            return false;
+        events.resize(eventCount);
+        for (size_t i = 0; i < eventCount; ++i) {
+            const uint8_t* data = &bytes[headerBytes + i * inputfile::EVENT_BYTES];
+            events[i].timeMicros = inputfile::get(data, 8);
+            events[i].tick = static_cast<uint32_t>(inputfile::get(data + 8, 4));
+            events[i].key = static_cast<uint16_t>(inputfile::get(data + 12, 2));
+            events[i].action = data[14];
+            events[i].reserved = 0;
+        }
+        next = 0;
+        return true;
+    }
+
+    // Apply every event due at or before `tick`; `pressAction` is GLFW_PRESS
+    void apply(uint32_t tick, InputState& state, int pressAction) {
+        while (next < events.size() && events[next].tick <= tick) {
+            state.set(events[next].key, events[next].action == pressAction);
+            ++next;
+        }
+    }
+
+    bool finished(uint32_t tick) const { return tick >= tickCount; }
+    uint32_t ticks() const { return tickCount; }
+
+private:
+    std::vector<InputEvent> events;
+    size_t next = 0;
+    uint32_t tickCount = 0;
+};
@@ -0,0 +1,302 @@
+#pragma once
+
+// Work-stealing job scheduler used for the per-frame CPU work (animation,
+// transform updates, culling, CPU vertex generation).
+//
+// Every thread that runs jobs owns a deque: it pushes and pops work at the
+// back, idle threads steal from the front of someone else's deque. The thread
+// that constructs the JobSystem is worker 0 and runs jobs whenever it waits,
+// so the main thread is never parked while there is frame work left.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Job {
+    std::function<void()> function;
+    std::string name;
+    std::atomic<int> pendingDependencies{ 1 }; // +1 until the job is submitted
+    std::atomic<bool> finished{ false };
+    std::mutex dependentsMutex;
+    std::vector<Job*> dependents;
+    bool dependentsReleased = false; // guarded by dependentsMutex
+};
+
+// How long one job ran and on which worker
+struct JobTiming {
+    std::string name;
+    unsigned int worker;
+    double startMs;
+    double durationMs;
+};
+
+class JobSystem {
+public:
+    // workerCount == 0 uses every hardware thread (including the calling one)
+    explicit JobSystem(unsigned int workerCount = 0) {
+        if (workerCount == 0)
+            workerCount = std::max(1u, std::thread::hardware_concurrency());
+        queues.resize(workerCount);
+        for (auto& queue : queues)
+            queue = std::make_unique<WorkQueue>();
+        epoch = Clock::now();
+        currentWorker() = 0;
+        for (unsigned int i = 1; i < workerCount; ++i)
+            threads.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    ~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            running = false;
+        }
+        wakeCondition.notify_all();
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    unsigned int workerCount() const { return static_cast<unsigned int>(queues.size()); }
+
+    // Make `job` wait for `dependency`; must be called before submit(job)
+    void addDependency(Job& job, Job& dependency) {
+        std::lock_guard<std::mutex> lock(dependency.dependentsMutex);
+        if (dependency.dependentsReleased)
+            return;
+        job.pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+        dependency.dependents.push_back(&job);
+    }
+
+    // Release the job; it runs as soon as all of its dependencies finished
+    void submit(Job& job) {
+        if (job.pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            push(&job);
+    }
+
+    // Run other jobs until `job` has finished
+    void wait(const Job& job) {
+        while (!job.finished.load(std::memory_order_acquire)) {
+            if (!runOne(currentWorker()))
+                std::this_thread::yield();
+        }
+    }
+
+    // Split [begin, end) into chunks of at most `grain` indices and run
+    // body(chunkBegin, chunkEnd) on them in parallel. Returns once every chunk
+    // is done; the calling thread works on chunks meanwhile.
+    void parallelFor(const std::string& name, size_t begin, size_t end, size_t grain,
+        const std::function<void(size_t, size_t)>& body) {
+        if (begin >= end)
+            return;
+        grain = std::max<size_t>(1, grain);
+        size_t chunkCount = (end - begin + grain - 1) / grain;
+        std::string chunkName = name + " (chunk)";
+        if (chunkCount == 1) {
+            Job job;
+            job.name = chunkName;
+            job.function = [&] { body(begin, end); };
+            execute(&job, currentWorker());
+            return;
+        }
+
+        std::vector<std::unique_ptr<Job>> chunks(chunkCount);
+        for (size_t c = 0; c < chunkCount; ++c) {
+            size_t chunkBegin = begin + c * grain;
+            size_t chunkEnd = std::min(end, chunkBegin + grain);
+            chunks[c] = std::make_unique<Job>();
+            chunks[c]->name = chunkName;
+            chunks[c]->function = [&body, chunkBegin, chunkEnd] { body(chunkBegin, chunkEnd); };
+        }
+        // Push in reverse so the owner pops chunks front to back
+        for (size_t c = chunkCount; c-- > 0;)
+            submit(*chunks[c]);
+        for (auto& chunk : chunks)
+            wait(*chunk);
+    }
+
+    // Timings of every job that finished since the last call
+    std::vector<JobTiming> takeTimings() {
+        std::lock_guard<std::mutex> lock(timingMutex);
+        std::vector<JobTiming> result;
+        result.swap(timings);
+        return result;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job*> jobs;
+    };
+
+    static unsigned int& currentWorker() {
+        thread_local unsigned int index = 0;
+        return index;
+    }
+
+    void push(Job* job) {
+        WorkQueue& queue = *queues[currentWorker() % queues.size()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_back(job);
+        }
+        queuedJobs.fetch_add(1, std::memory_order_release);
+        if (sleepingWorkers.load(std::memory_order_acquire) > 0) {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            wakeCondition.notify_one();
+        }
+    }
+
+    Job* pop(unsigned int worker) {
+        WorkQueue& queue = *queues[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty())
+            return nullptr;
+        Job* job = queue.jobs.back();
+        queue.jobs.pop_back();
+        return job;
+    }
+
+    Job* steal(unsigned int thief) {
+        size_t count = queues.size();
+        for (size_t offset = 1; offset < count; ++offset) {
+            WorkQueue& queue = *queues[(thief + offset) % count];
+            std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+            if (!lock.owns_lock() || queue.jobs.empty())
+                continue;
+            Job* job = queue.jobs.front();
+            queue.jobs.pop_front();
+            return job;
+        }
+        return nullptr;
+    }
+
+    bool runOne(unsigned int worker) {
+        Job* job = pop(worker);
+        if (!job)
+            job = steal(worker);
+        if (!job)
+            return false;
+        queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        execute(job, worker);
+        return true;
+    }
+
+    void execute(Job* job, unsigned int worker) {
+        Clock::time_point start = Clock::now();
+        if (job->function)
+            job->function();
+        Clock::time_point stop = Clock::now();
+        {
+            std::lock_guard<std::mutex> lock(timingMutex);
+            timings.push_back({ job->name, worker,
+                std::chrono::duration<double, std::milli>(start - epoch).count(),
+                std::chrono::duration<double, std::milli>(stop - start).count() });
+        }
+
+        std::vector<Job*> ready;
+        {
+            std::lock_guard<std::mutex> lock(job->dependentsMutex);
+            job->dependentsReleased = true;
+            ready.swap(job->dependents);
+        }
+        for (Job* dependent : ready)
+            submit(*dependent);
+        // Last touch: a waiter may destroy the job as soon as it sees this
+        job->finished.store(true, std::memory_order_release);
+    }
+
+    void workerLoop(unsigned int worker) {
+        currentWorker() = worker;
+        while (running.load(std::memory_order_acquire)) {
+            if (runOne(worker))
+                continue;
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleepingWorkers.fetch_add(1, std::memory_order_acq_rel);
+            wakeCondition.wait_for(lock, std::chrono::milliseconds(1), [this] {
+                return !running.load(std::memory_order_acquire) ||
+                    queuedJobs.load(std::memory_order_acquire) > 0;
+            });
+            sleepingWorkers.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<bool> running{ true };
+    std::atomic<int> queuedJobs{ 0 };
+    std::atomic<int> sleepingWorkers{ 0 };
+    std::mutex sleepMutex;
+    std::condition_variable wakeCondition;
+
+    Clock::time_point epoch;
+    std::mutex timingMutex;
+    std::vector<JobTiming> timings;
+};
+
+// Frame-scoped job graph: describe this frame's work as named jobs with
+// dependencies, run it, and throw it away. Jobs live as long as the graph.
+class JobGraph {
+public:
+    using JobId = size_t;
+
+    explicit JobGraph(JobSystem& jobSystem) : jobs(jobSystem) {}
+
+    JobId add(const std::string& name, std::function<void()> function,
+        std::initializer_list<JobId> dependencies = {}) {
+        nodes.push_back(std::make_unique<Job>());
+        Job& job = *nodes.back();
+        job.name = name;
+        job.function = std::move(function);
+        for (JobId dependency : dependencies)
+            jobs.addDependency(job, *nodes[dependency]);
+        return nodes.size() - 1;
+    }
+
+    // A node that runs body over [0, count) with JobSystem::parallelFor
+    JobId addParallelFor(const std::string& name, size_t count, size_t grain,
+        std::function<void(size_t, size_t)> body, std::initializer_list<JobId> dependencies = {}) {
+        JobSystem* system = &jobs;
+        return add(name, [system, name, count, grain, body = std::move(body)] {
+            system->parallelFor(name, 0, count, grain, body);
+        }, dependencies);
+    }
+
+    // Submit every node and block (while helping) until all of them finished
+    void run() {
+        for (auto& node : nodes)
+            jobs.submit(*node);
+        for (auto& node : nodes)
+            jobs.wait(*node);
+    }
+
+private:
+    JobSystem& jobs;
+    std::vector<std::unique_ptr<Job>> nodes;
+};
+
+// Average duration per job name, e.g. for a periodic console report
+inline std::map<std::string, double> summarizeJobTimings(const std::vector<JobTiming>& timings,
+    unsigned int frameCount) {
+    std::map<std::string, double> totals;
+    for (const JobTiming& timing : timings)
+        totals[timing.name] += timing.durationMs;
+    if (frameCount > 0) {
+        for (auto& entry : totals)
+            entry.second /= frameCount;
+    }
+    return totals;
+}
@@ -0,0 +1,288 @@
+#pragma once
+
+// Small JSON DOM parser, enough for asset manifests such as glTF.
+// Lookups of missing keys or indices return a shared null value, so chains
+// like doc["nodes"][3]["mesh"].asInt(-1) never need explicit checks.
+
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+class JsonValue {
+public:
+    enum class Type { Null, Bool, Number, String, Array, Object };
+
+    Type type = Type::Null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    bool isNull() const { return type == Type::Null; }
+    bool isNumber() const { return type == Type::Number; }
+    bool isString() const { return type == Type::String; }
+    bool isArray() const { return type == Type::Array; }
+    bool isObject() const { return type == Type::Object; }
+
+    bool has(const std::string& key) const { return !(*this)[key].isNull(); }
+
+    size_t size() const {
+        return type == Type::Array ? array.size() : type == Type::Object ? object.size() : 0;
+    }
+
+    const JsonValue& operator[](const std::string& key) const {
+        if (type == Type::Object) {
+            for (const auto& member : object) {
+                if (member.first == key)
+                    return member.second;
+            }
+        }
+        return null();
+    }
+
+    const JsonValue& operator[](size_t index) const {
+        return type == Type::Array && index < array.size() ? array[index] : null();
+    }
+
+    double asNumber(double fallback = 0.0) const { return type == Type::Number ? number : fallback; }
+    // `fallback` as well for fractions and numbers outside the int64_t range
+    int64_t asInt(int64_t fallback = 0) const {
+        if (type != Type::Number || !(number >= -9223372036854775808.0 && number < 9223372036854775808.0))
+            return fallback;
+        int64_t value = static_cast<int64_t>(number);
+        return static_cast<double>(value) == number ? value : fallback;
+    }
+    bool asBool(bool fallback = false) const { return type == Type::Bool ? boolean : fallback; }
+    const std::string& asString() const { return type == Type::String ? string : null().string; }
+
+    static const JsonValue& null() {
+        static const JsonValue value;
+        return value;
+    }
+};
+
+namespace jsondetail {
+
+class Parser {
+public:
+    Parser(const char* begin, const char* end) : p(begin), end(end) {}
+
+    bool parseDocument(JsonValue& value, std::string& error) {
+        if (!parseValue(value, 0)) {
+            error = message;
+            return false;
+        }
+        skipSpace();
+        if (p != end) {
+            error = "trailing characters after JSON document";
+            return false;
+        }
+        return true;
+    }
+
+private:
+    bool fail(const char* what) {
+        message = what;
+        return false;
+    }
+
+    void skipSpace() {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+            ++p;
+    }
+
+    bool literal(const char* word) {
+        const char* q = p;
+        for (; *word; ++word, ++q) {
+            if (q >= end || *q != *word)
+                return false;
+        }
+        p = q;
+        return true;
+    }
+
+    bool parseValue(JsonValue& value, int depth) {
+        if (depth > 256)
+            return fail("JSON nested too deeply");
+        skipSpace();
+        if (p >= end)
+            return fail("unexpected end of JSON");
+        switch (*p) {
+        case '{': return parseObject(value, depth);
+        case '[': return parseArray(value, depth);
+        case '"':
+            value.type = JsonValue::Type::String;
+            return parseString(value.string);
+        case 't':
+        case 'f':
+            value.type = JsonValue::Type::Bool;
+            value.boolean = *p == 't';
+            return literal(value.boolean ? "true" : "false") || fail("invalid literal");
+        case 'n':
+            value.type = JsonValue::Type::Null;
+            return literal("null") || fail("invalid literal");
+        default:
+            return parseNumber(value);
+        }
+    }
+
+    bool parseNumber(JsonValue& value) {
+        std::from_chars_result result = std::from_chars(p, end, value.number);
+        if (result.ec != std::errc())
+            return fail("invalid number");
+        value.type = JsonValue::Type::Number;
+        p = result.ptr;
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t codePoint) {
+        if (codePoint < 0x80) {
+            out += static_cast<char>(codePoint);
+        } else if (codePoint < 0x800) {
+            out += static_cast<char>(0xC0 | (codePoint >> 6));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else if (codePoint < 0x10000) {
+            out += static_cast<char>(0xE0 | (codePoint >> 12));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (codePoint >> 18));
+            out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    bool parseHex4(uint32_t& value) {
+        if (end - p < 4)
+            return false;
+        value = 0;
+        for (int i = 0; i < 4; ++i, ++p) {
+            char c = *p;
+            value <<= 4;
+            if (c >= '0' && c <= '9') value |= static_cast<uint32_t>(c - '0');
+            else if (c >= 'a' && c <= 'f') value |= static_cast<uint32_t>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') value |= static_cast<uint32_t>(c - 'A' + 10);
+            else return false;
+        }
+        return true;
+    }
+
+    bool parseString(std::string& out) {
+        ++p; // Opening quote
+        out.clear();
+        while (p < end && *p != '"') {
+            if (*p != '\\') {
+                out += *p++;
+                continue;
+            }
+            if (++p >= end)
+                break;
+            char escape = *p++;
+            switch (escape) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                uint32_t codePoint;
+                if (!parseHex4(codePoint))
+                    return fail("invalid \\u escape");
+                if (codePoint >= 0xD800 && codePoint < 0xDC00 && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                    p += 2;
+                    uint32_t low;
+                    if (!parseHex4(low))
+                        return fail("invalid \\u escape");
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+                appendUtf8(out, codePoint);
+                break;
+            }
+            default:
+                return fail("invalid escape");
+            }
+        }
+        if (p >= end)
+            return fail("unterminated string");
+        ++p; // Closing quote
+        return true;
+    }
+
+    bool parseArray(JsonValue& value, int depth) {
+        value.type = JsonValue::Type::Array;
+        ++p;
+        skipSpace();
+        if (p < end && *p == ']') {
+            ++p;
+            return true;
+        }
+        while (true) {
+            value.array.emplace_back();
+            if (!parseValue(value.array.back(), depth + 1))
+                return false;
+            skipSpace();
+            if (p < end && *p == ',') {
+                ++p;
+                continue;
+            }
+            if (p < end && *p == ']') {
+                ++p;
+                return true;
+            }
+            return fail("expected , or ] in array");
+        }
+    }
+
+    bool parseObject(JsonValue& value, int depth) {
+        value.type = JsonValue::Type::Object;
+        ++p;
+        skipSpace();
+        if (p < end && *p == '}') {
+            ++p;
+            return true;
+        }
+        while (true) {
+            skipSpace();
+            if (p >= end || *p != '"')
+                return fail("expected member name");
+            value.object.emplace_back();
+            if (!parseString(value.object.back().first))
+                return false;
+            skipSpace();
+            if (p >= end || *p != ':')
+                return fail("expected : after member name");
+            ++p;
+            if (!parseValue(value.object.back().second, depth + 1))
+                return false;
+            skipSpace();
+            if (p < end && *p == ',') {
+                ++p;
+                continue;
+            }
+            if (p < end && *p == '}') {
+                ++p;
+                return true;
+            }
+            return fail("expected , or } in object");
+        }
+    }
+
+    const char* p;
+    const char* end;
+    const char* message = "";
+};
+
+} // namespace jsondetail
+
+inline bool parseJson(const char* begin, const char* end, JsonValue& value, std::string& error) {
+    jsondetail::Parser parser(begin, end);
+    return parser.parseDocument(value, error);
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "setup.hpp"
+#include <cmath>
 #include <limits>
 
 namespace glm{
@@ -46,5 +47,137 @@ namespace detail
 			return x;
 		}
 	};
+
+	// True while a constant expression is evaluated. Without compiler support it is always false and the functions
+	// below call the C++ library at compile time too, so they are only usable at run time.
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR bool is_constant_evaluated()
+	{
+#		if GLM_HAS_CONSTANT_EVALUATED
+			return __builtin_is_constant_evaluated();
+#		else
+			return false;
+#		endif
+	}
+
+	// Precision the series below are evaluated in: at least double, so float results are correctly rounded
+	template<typename genType>
+	struct compute_series_type
+	{
+		typedef genType type;
+	};
+
+	template<>
+	struct compute_series_type<float>
+	{
+		typedef double type;
+	};
+
+	// Square root by Newton's method after scaling into [1, 4) by powers of 4, which is exact
+	template<typename genType>
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR genType compute_sqrt_series(genType x)
+	{
+		if(x != x || x == static_cast<genType>(0) || x == std::numeric_limits<genType>::infinity())
+			return x;
+		if(x < static_cast<genType>(0))
+			return std::numeric_limits<genType>::quiet_NaN();
+
+		genType Scale(1);
+		while(x >= static_cast<genType>(4))
+		{
+			x /= static_cast<genType>(4);
+			Scale *= static_cast<genType>(2);
+		}
+		while(x < static_cast<genType>(1))
+		{
+			x *= static_cast<genType>(4);
+			Scale /= static_cast<genType>(2);
+		}
+
+		genType Result = (x + static_cast<genType>(2)) / static_cast<genType>(3);
+		for(int i = 0; i < 6; ++i)
+			Result = (Result + x / Result) / static_cast<genType>(2);
+		return Result * Scale;
+	}
+
+	// Angle reduced to [-pi, pi]
+	template<typename genType>
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR genType compute_reduce_angle(genType x)
+	{
+		genType const TwoPi = static_cast<genType>(6.28318530717958647692528676655900576);
+		genType const Turns = x / TwoPi;
+		genType const Half = Turns < static_cast<genType>(0) ? static_cast<genType>(-0.5) : static_cast<genType>(0.5);
+		return x - static_cast<genType>(static_cast<long long>(Turns + Half)) * TwoPi;
+	}
+
+	// Taylor series of the sine, for x in [-pi/2, pi/2]
+	template<typename genType>
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR genType compute_sin_taylor(genType x)
+	{
+		genType const Square = x * x;
+		genType Term = x;
+		genType Result = x;
+		for(int n = 1; n < 16; ++n)
+		{
+			Term *= -Square / static_cast<genType>((2 * n) * (2 * n + 1));
+			Result += Term;
+		}
+		return Result;
+	}
+
+	template<typename genType>
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR genType compute_sin_series(genType x)
+	{
+		genType const Pi = static_cast<genType>(3.14159265358979323846264338327950288);
+		if(x != x || x - x != static_cast<genType>(0)) // NaN or infinite
+			return std::numeric_limits<genType>::quiet_NaN();
+		x = compute_reduce_angle(x);
+		if(x > Pi / static_cast<genType>(2))
+			x = Pi - x;
+		else if(x < -Pi / static_cast<genType>(2))
+			x = -Pi - x;
+		return compute_sin_taylor(x);
+	}
+
+	// cos(x) = sin(pi/2 - |x|), which stays in [-pi/2, pi/2] once x is in [-pi, pi]
+	template<typename genType>
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR genType compute_cos_series(genType x)
+	{
+		genType const HalfPi = static_cast<genType>(1.57079632679489661923132169163975144);
+		if(x != x || x - x != static_cast<genType>(0))
+			return std::numeric_limits<genType>::quiet_NaN();
+		x = compute_reduce_angle(x);
+		return compute_sin_taylor(HalfPi - (x < static_cast<genType>(0) ? -x : x));
+	}
+
+	// std::sqrt, std::sin, std::cos and std::tan at run time; the series above in constant expressions
+	template<typename genType>
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR genType compute_sqrt_constexpr(genType x)
+	{
+		typedef typename compute_series_type<genType>::type series_type;
+		return is_constant_evaluated() ? static_cast<genType>(compute_sqrt_series(static_cast<series_type>(x))) : std::sqrt(x);
+	}
+
+	template<typename genType>
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR genType compute_sin_constexpr(genType x)
+	{
+		typedef typename compute_series_type<genType>::type series_type;
+		return is_constant_evaluated() ? static_cast<genType>(compute_sin_series(static_cast<series_type>(x))) : std::sin(x);
+	}
+
+	template<typename genType>
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR genType compute_cos_constexpr(genType x)
+	{
+		typedef typename compute_series_type<genType>::type series_type;
+		return is_constant_evaluated() ? static_cast<genType>(compute_cos_series(static_cast<series_type>(x))) : std::cos(x);
+	}
+
+	template<typename genType>
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR genType compute_tan_constexpr(genType x)
+	{
+		typedef typename compute_series_type<genType>::type series_type;
+		return is_constant_evaluated()
+			? static_cast<genType>(compute_sin_series(static_cast<series_type>(x)) / compute_cos_series(static_cast<series_type>(x)))
+			: std::tan(x);
+	}
 }//namespace detail
 }//namespace glm
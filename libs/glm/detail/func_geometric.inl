@@ -1,5 +1,6 @@
 #include "../exponential.hpp"
 #include "../common.hpp"
+#include "compute_common.hpp"
 
 namespace glm{
 namespace detail
@@ -7,16 +8,16 @@ namespace detail
 	template<length_t L, typename T, qualifier Q, bool Aligned>
 	struct compute_length
 	{
-		GLM_FUNC_QUALIFIER static T call(vec<L, T, Q> const& v)
+		GLM_FUNC_QUALIFIER GLM_CONSTEXPR static T call(vec<L, T, Q> const& v)
 		{
-			return sqrt(dot(v, v));
+			return compute_sqrt_constexpr(dot(v, v));
 		}
 	};
 
 	template<length_t L, typename T, qualifier Q, bool Aligned>
 	struct compute_distance
 	{
-		GLM_FUNC_QUALIFIER static T call(vec<L, T, Q> const& p0, vec<L, T, Q> const& p1)
+		GLM_FUNC_QUALIFIER GLM_CONSTEXPR static T call(vec<L, T, Q> const& p0, vec<L, T, Q> const& p1)
 		{
 			return length(p1 - p0);
 		}
@@ -97,11 +98,11 @@ namespace detail
 	template<length_t L, typename T, qualifier Q, bool Aligned>
 	struct compute_normalize
 	{
-		GLM_FUNC_QUALIFIER static vec<L, T, Q> call(vec<L, T, Q> const& v)
+		GLM_FUNC_QUALIFIER GLM_CONSTEXPR static vec<L, T, Q> call(vec<L, T, Q> const& v)
 		{
 			GLM_STATIC_ASSERT(std::numeric_limits<T>::is_iec559, "'normalize' accepts only floating-point inputs");
 
-			return v * inversesqrt(dot(v, v));
+			return v * (static_cast<T>(1) / compute_sqrt_constexpr(dot(v, v)));
 		}
 	};
 
@@ -149,7 +150,7 @@ namespace detail
 	}
 
 	template<length_t L, typename T, qualifier Q>
-	GLM_FUNC_QUALIFIER T length(vec<L, T, Q> const& v)
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR T length(vec<L, T, Q> const& v)
 	{
 		GLM_STATIC_ASSERT(std::numeric_limits<T>::is_iec559, "'length' accepts only floating-point inputs");
 
@@ -166,7 +167,7 @@ namespace detail
 	}
 
 	template<length_t L, typename T, qualifier Q>
-	GLM_FUNC_QUALIFIER T distance(vec<L, T, Q> const& p0, vec<L, T, Q> const& p1)
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR T distance(vec<L, T, Q> const& p0, vec<L, T, Q> const& p1)
 	{
 		return detail::compute_distance<L, T, Q, detail::is_aligned<Q>::value>::call(p0, p1);
 	}
@@ -203,7 +204,7 @@ namespace detail
 	}
 */
 	template<length_t L, typename T, qualifier Q>
-	GLM_FUNC_QUALIFIER vec<L, T, Q> normalize(vec<L, T, Q> const& x)
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<L, T, Q> normalize(vec<L, T, Q> const& x)
 	{
 		GLM_STATIC_ASSERT(std::numeric_limits<T>::is_iec559, "'normalize' accepts only floating-point inputs");
 
@@ -54,7 +54,7 @@ namespace detail
 	template<typename T, qualifier Q, bool Aligned>
 	struct compute_transpose<2, 2, T, Q, Aligned>
 	{
-		GLM_FUNC_QUALIFIER static mat<2, 2, T, Q> call(mat<2, 2, T, Q> const& m)
+		GLM_FUNC_QUALIFIER GLM_CONSTEXPR static mat<2, 2, T, Q> call(mat<2, 2, T, Q> const& m)
 		{
 			mat<2, 2, T, Q> Result(1);
 			Result[0][0] = m[0][0];
@@ -68,7 +68,7 @@ namespace detail
 	template<typename T, qualifier Q, bool Aligned>
 	struct compute_transpose<2, 3, T, Q, Aligned>
 	{
-		GLM_FUNC_QUALIFIER static mat<3, 2, T, Q> call(mat<2, 3, T, Q> const& m)
+		GLM_FUNC_QUALIFIER GLM_CONSTEXPR static mat<3, 2, T, Q> call(mat<2, 3, T, Q> const& m)
 		{
 			mat<3,2, T, Q> Result(1);
 			Result[0][0] = m[0][0];
@@ -84,7 +84,7 @@ namespace detail
 	template<typename T, qualifier Q, bool Aligned>
 	struct compute_transpose<2, 4, T, Q, Aligned>
 	{
-		GLM_FUNC_QUALIFIER static mat<4, 2, T, Q> call(mat<2, 4, T, Q> const& m)
+		GLM_FUNC_QUALIFIER GLM_CONSTEXPR static mat<4, 2, T, Q> call(mat<2, 4, T, Q> const& m)
 		{
 			mat<4, 2, T, Q> Result(1);
 			Result[0][0] = m[0][0];
@@ -102,7 +102,7 @@ namespace detail
 	template<typename T, qualifier Q, bool Aligned>
 	struct compute_transpose<3, 2, T, Q, Aligned>
 	{
-		GLM_FUNC_QUALIFIER static mat<2, 3, T, Q> call(mat<3, 2, T, Q> const& m)
+		GLM_FUNC_QUALIFIER GLM_CONSTEXPR static mat<2, 3, T, Q> call(mat<3, 2, T, Q> const& m)
 		{
 			mat<2, 3, T, Q> Result(1);
 			Result[0][0] = m[0][0];
@@ -118,7 +118,7 @@ namespace detail
 	template<typename T, qualifier Q, bool Aligned>
 	struct compute_transpose<3, 3, T, Q, Aligned>
 	{
-		GLM_FUNC_QUALIFIER static mat<3, 3, T, Q> call(mat<3, 3, T, Q> const& m)
+		GLM_FUNC_QUALIFIER GLM_CONSTEXPR static mat<3, 3, T, Q> call(mat<3, 3, T, Q> const& m)
 		{
 			mat<3, 3, T, Q> Result(1);
 			Result[0][0] = m[0][0];
@@ -139,7 +139,7 @@ namespace detail
 	template<typename T, qualifier Q, bool Aligned>
 	struct compute_transpose<3, 4, T, Q, Aligned>
 	{
-		GLM_FUNC_QUALIFIER static mat<4, 3, T, Q> call(mat<3, 4, T, Q> const& m)
+		GLM_FUNC_QUALIFIER GLM_CONSTEXPR static mat<4, 3, T, Q> call(mat<3, 4, T, Q> const& m)
 		{
 			mat<4, 3, T, Q> Result(1);
 			Result[0][0] = m[0][0];
@@ -161,7 +161,7 @@ namespace detail
 	template<typename T, qualifier Q, bool Aligned>
 	struct compute_transpose<4, 2, T, Q, Aligned>
 	{
-		GLM_FUNC_QUALIFIER static mat<2, 4, T, Q> call(mat<4, 2, T, Q> const& m)
+		GLM_FUNC_QUALIFIER GLM_CONSTEXPR static mat<2, 4, T, Q> call(mat<4, 2, T, Q> const& m)
 		{
 			mat<2, 4, T, Q> Result(1);
 			Result[0][0] = m[0][0];
@@ -179,7 +179,7 @@ namespace detail
 	template<typename T, qualifier Q, bool Aligned>
 	struct compute_transpose<4, 3, T, Q, Aligned>
 	{
-		GLM_FUNC_QUALIFIER static mat<3, 4, T, Q> call(mat<4, 3, T, Q> const& m)
+		GLM_FUNC_QUALIFIER GLM_CONSTEXPR static mat<3, 4, T, Q> call(mat<4, 3, T, Q> const& m)
 		{
 			mat<3, 4, T, Q> Result(1);
 			Result[0][0] = m[0][0];
@@ -201,7 +201,7 @@ namespace detail
 	template<typename T, qualifier Q, bool Aligned>
 	struct compute_transpose<4, 4, T, Q, Aligned>
 	{
-		GLM_FUNC_QUALIFIER static mat<4, 4, T, Q> call(mat<4, 4, T, Q> const& m)
+		GLM_FUNC_QUALIFIER GLM_CONSTEXPR static mat<4, 4, T, Q> call(mat<4, 4, T, Q> const& m)
 		{
 			mat<4, 4, T, Q> Result(1);
 			Result[0][0] = m[0][0];
@@ -229,7 +229,7 @@ namespace detail
 
 	template<length_t C, length_t R, typename T, qualifier Q, bool IsFloat, bool Aligned>
 	struct compute_transpose_type {
-		GLM_FUNC_QUALIFIER static mat<R, C, T, Q> call(mat<C, R, T, Q> const& m)
+		GLM_FUNC_QUALIFIER GLM_CONSTEXPR static mat<R, C, T, Q> call(mat<C, R, T, Q> const& m)
 		{
 			GLM_STATIC_ASSERT(std::numeric_limits<T>::is_iec559 || GLM_CONFIG_UNRESTRICTED_GENTYPE, 
 				"'transpose' only accept floating-point inputs, include <glm/ext/matrix_integer.hpp> to discard this restriction.");
@@ -459,7 +459,7 @@ namespace detail
 	}
 
 	template<length_t C, length_t R, typename T, qualifier Q>
-	GLM_FUNC_QUALIFIER typename mat<C, R, T, Q>::transpose_type transpose(mat<C, R, T, Q> const& m)
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR typename mat<C, R, T, Q>::transpose_type transpose(mat<C, R, T, Q> const& m)
 	{
 		return detail::compute_transpose_type<C, R, T, Q, std::numeric_limits<T>::is_iec559, detail::is_aligned<Q>::value>::call(m);
 	}
@@ -294,7 +294,9 @@
 
 // N2235 Generalized Constant Expressions http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2007/n2235.pdf
 // N3652 Extended Constant Expressions http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2013/n3652.html
-#if (GLM_ARCH & GLM_ARCH_SIMD_BIT) // Compiler SIMD intrinsics don't support constexpr...
+// SIMD builds keep constexpr: the SIMD specializations (aligned types) are not constexpr themselves, so only
+// the packed types, which never reach intrinsics, can be used in constant expressions.
+#if (GLM_ARCH & GLM_ARCH_SIMD_BIT) && !(GLM_LANG & GLM_LANG_CXX14_FLAG)
 #	define GLM_HAS_CONSTEXPR 0
 #elif (GLM_COMPILER & GLM_COMPILER_CLANG)
 #	define GLM_HAS_CONSTEXPR __has_feature(cxx_relaxed_constexpr)
@@ -312,6 +314,20 @@
 #	define GLM_CONSTEXPR
 #endif
 
+// P0595 std::is_constant_evaluated http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2018/p0595r2.html
+// The builtin behind it is available in every language mode from GCC 9, Clang 9 and Visual C++ 2019 16.5
+#if !GLM_HAS_CONSTEXPR
+#	define GLM_HAS_CONSTANT_EVALUATED 0
+#elif defined(__clang__)
+#	define GLM_HAS_CONSTANT_EVALUATED __has_builtin(__builtin_is_constant_evaluated)
+#elif (GLM_COMPILER & GLM_COMPILER_GCC) && defined(__GNUC__) && (__GNUC__ >= 9)
+#	define GLM_HAS_CONSTANT_EVALUATED 1
+#elif (GLM_COMPILER & GLM_COMPILER_VC) && defined(_MSC_VER) && (_MSC_VER >= 1925)
+#	define GLM_HAS_CONSTANT_EVALUATED 1
+#else
+#	define GLM_HAS_CONSTANT_EVALUATED 0
+#endif
+
 //
 #if GLM_HAS_CONSTEXPR
 # if (GLM_COMPILER & GLM_COMPILER_CLANG)
@@ -859,7 +859,7 @@ namespace glm {
 
 	template<>
 	template<>
-	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<3, double, aligned_highp>::vec(const vec<3, double, aligned_highp>& v)
+	GLM_FUNC_QUALIFIER vec<3, double, aligned_highp>::vec(const vec<3, double, aligned_highp>& v)
 #if (GLM_ARCH & GLM_ARCH_AVX_BIT)
 		:data(v.data) {}
 #else
@@ -874,19 +874,19 @@ namespace glm {
 
 	template<>
 	template<>
-	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<3, float, aligned_highp>::vec(const vec<3, float, aligned_highp>& v) :
+	GLM_FUNC_QUALIFIER vec<3, float, aligned_highp>::vec(const vec<3, float, aligned_highp>& v) :
 		data(v.data) {}
 
 	template<>
 	template<>
-	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<3, float, aligned_highp>::vec(const vec<3, float, packed_highp>& v)
+	GLM_FUNC_QUALIFIER vec<3, float, aligned_highp>::vec(const vec<3, float, packed_highp>& v)
 	{
 		data = _mm_set_ps(v[2], v[2], v[1], v[0]);
 	}
 
 	template<>
 	template<>
-	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<3, float, packed_highp>::vec(const vec<3, float, aligned_highp>& v)
+	GLM_FUNC_QUALIFIER vec<3, float, packed_highp>::vec(const vec<3, float, aligned_highp>& v)
 	{
 		_mm_store_sd(reinterpret_cast<double*>(this), _mm_castps_pd(v.data));
 		__m128 mz = _mm_shuffle_ps(v.data, v.data, _MM_SHUFFLE(2, 2, 2, 2));
@@ -895,7 +895,7 @@ namespace glm {
 
 	template<>
 	template<>
-	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<3, double, aligned_highp>::vec(const vec<3, double, packed_highp>& v)
+	GLM_FUNC_QUALIFIER vec<3, double, aligned_highp>::vec(const vec<3, double, packed_highp>& v)
 	{
 #if (GLM_ARCH & GLM_ARCH_AVX_BIT)
 		data = _mm256_set_pd(v[2], v[2], v[1], v[0]);
@@ -907,7 +907,7 @@ namespace glm {
 
 	template<>
 	template<>
-	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<3, double, packed_highp>::vec(const vec<3, double, aligned_highp>& v)
+	GLM_FUNC_QUALIFIER vec<3, double, packed_highp>::vec(const vec<3, double, aligned_highp>& v)
 	{
 #if (GLM_ARCH & GLM_ARCH_AVX_BIT)
 		__m256d T1 = _mm256_permute_pd(v.data, 1);
@@ -922,14 +922,14 @@ namespace glm {
 
 	template<>
 	template<>
-	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<3, int, aligned_highp>::vec(const vec<3, int, aligned_highp>& v) :
+	GLM_FUNC_QUALIFIER vec<3, int, aligned_highp>::vec(const vec<3, int, aligned_highp>& v) :
 		data(v.data)
 	{
 	}
 
 	template<>
 	template<>
-	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<3, int, aligned_highp>::vec(const vec<3, int, packed_highp>& v)
+	GLM_FUNC_QUALIFIER vec<3, int, aligned_highp>::vec(const vec<3, int, packed_highp>& v)
 	{
 		__m128 mx = _mm_load_ss(reinterpret_cast<const float*>(&v[0]));
 		__m128 my = _mm_load_ss(reinterpret_cast<const float*>(&v[1]));
@@ -940,7 +940,7 @@ namespace glm {
 
 	template<>
 	template<>
-	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<3, int, packed_highp>::vec(const vec<3, int, aligned_highp>& v)
+	GLM_FUNC_QUALIFIER vec<3, int, packed_highp>::vec(const vec<3, int, aligned_highp>& v)
 	{
 		_mm_store_sd(reinterpret_cast<double*>(this), _mm_castsi128_pd(v.data));
 		__m128 mz = _mm_shuffle_ps(_mm_castsi128_ps(v.data), _mm_castsi128_ps(v.data), _MM_SHUFFLE(2, 2, 2, 2));
@@ -949,14 +949,14 @@ namespace glm {
 
 	template<>
 	template<>
-	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<3, unsigned int, aligned_highp>::vec(const vec<3, unsigned int, aligned_highp>& v) :
+	GLM_FUNC_QUALIFIER vec<3, unsigned int, aligned_highp>::vec(const vec<3, unsigned int, aligned_highp>& v) :
 		data(v.data)
 	{
 	}
 
 	template<>
 	template<>
-	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<3, unsigned int, aligned_highp>::vec(const vec<3, unsigned int, packed_highp>& v)
+	GLM_FUNC_QUALIFIER vec<3, unsigned int, aligned_highp>::vec(const vec<3, unsigned int, packed_highp>& v)
 	{
 		__m128 mx = _mm_load_ss(reinterpret_cast<const float*>(&v[0]));
 		__m128 my = _mm_load_ss(reinterpret_cast<const float*>(&v[1]));
@@ -967,7 +967,7 @@ namespace glm {
 
 	template<>
 	template<>
-	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<3, unsigned int, packed_highp>::vec(const vec<3, unsigned int, aligned_highp>& v)
+	GLM_FUNC_QUALIFIER vec<3, unsigned int, packed_highp>::vec(const vec<3, unsigned int, aligned_highp>& v)
 	{
 		_mm_store_sd(reinterpret_cast<double*>(this), _mm_castsi128_pd(v.data));
 		__m128 mz = _mm_shuffle_ps(_mm_castsi128_ps(v.data), _mm_castsi128_ps(v.data), _MM_SHUFFLE(2, 2, 2, 2));
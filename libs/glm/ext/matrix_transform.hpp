@@ -20,6 +20,7 @@
 #pragma once
 
 // Dependencies
+#include "../detail/compute_common.hpp"
 #include "../gtc/constants.hpp"
 #include "../geometric.hpp"
 #include "../trigonometric.hpp"
@@ -77,7 +78,7 @@ namespace glm
 	/// @see - rotate(T angle, vec<3, T, Q> const& v)
 	/// @see <a href="https://www.khronos.org/registry/OpenGL-Refpages/gl2.1/xhtml/glRotate.xml">glRotate man page</a>
 	template<typename T, qualifier Q>
-	GLM_FUNC_DECL mat<4, 4, T, Q> rotate(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, Q> rotate(
 		mat<4, 4, T, Q> const& m, T angle, vec<3, T, Q> const& axis);
 
 	/// Builds a scale 4 * 4 matrix created from 3 scalars.
@@ -92,7 +93,7 @@ namespace glm
 	/// @see - scale(vec<3, T, Q> const& v)
 	/// @see <a href="https://www.khronos.org/registry/OpenGL-Refpages/gl2.1/xhtml/glScale.xml">glScale man page</a>
 	template<typename T, qualifier Q>
-	GLM_FUNC_DECL mat<4, 4, T, Q> scale(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, Q> scale(
 		mat<4, 4, T, Q> const& m, vec<3, T, Q> const& v);
 
     /// Builds a scale 4 * 4 matrix created from point referent 3 shearers.
@@ -133,7 +134,7 @@ namespace glm
 	///
 	/// @see - frustum(T const& left, T const& right, T const& bottom, T const& top, T const& nearVal, T const& farVal) frustum(T const& left, T const& right, T const& bottom, T const& top, T const& nearVal, T const& farVal)
 	template<typename T, qualifier Q>
-	GLM_FUNC_DECL mat<4, 4, T, Q> lookAtRH(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, Q> lookAtRH(
 		vec<3, T, Q> const& eye, vec<3, T, Q> const& center, vec<3, T, Q> const& up);
 
 	/// Build a left handed look at view matrix.
@@ -147,7 +148,7 @@ namespace glm
 	///
 	/// @see - frustum(T const& left, T const& right, T const& bottom, T const& top, T const& nearVal, T const& farVal) frustum(T const& left, T const& right, T const& bottom, T const& top, T const& nearVal, T const& farVal)
 	template<typename T, qualifier Q>
-	GLM_FUNC_DECL mat<4, 4, T, Q> lookAtLH(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, Q> lookAtLH(
 		vec<3, T, Q> const& eye, vec<3, T, Q> const& center, vec<3, T, Q> const& up);
 
 	/// Build a look at view matrix based on the default handedness.
@@ -162,7 +163,7 @@ namespace glm
 	/// @see - frustum(T const& left, T const& right, T const& bottom, T const& top, T const& nearVal, T const& farVal) frustum(T const& left, T const& right, T const& bottom, T const& top, T const& nearVal, T const& farVal)
 	/// @see <a href="https://www.khronos.org/registry/OpenGL-Refpages/gl2.1/xhtml/gluLookAt.xml">gluLookAt man page</a>
 	template<typename T, qualifier Q>
-	GLM_FUNC_DECL mat<4, 4, T, Q> lookAt(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, Q> lookAt(
 		vec<3, T, Q> const& eye, vec<3, T, Q> const& center, vec<3, T, Q> const& up);
 
 	/// @}
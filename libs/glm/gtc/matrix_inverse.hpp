@@ -8,7 +8,8 @@
 ///
 /// Include <glm/gtc/matrix_inverse.hpp> to use the features of this extension.
 ///
-/// Defines additional matrix inverting functions.
+/// Defines additional matrix inverting functions, for single matrices and
+/// for arrays of them.
 
 #pragma once
 
@@ -18,6 +19,7 @@
 #include "../mat2x2.hpp"
 #include "../mat3x3.hpp"
 #include "../mat4x4.hpp"
+#include <cstddef>
 
 #if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
 #	pragma message("GLM: GLM_GTC_matrix_inverse extension included")
@@ -44,6 +46,29 @@ namespace glm
 	template<typename genType>
 	GLM_FUNC_DECL genType inverseTranspose(genType const& m);
 
+	/// Fast inverse of count affine matrices: out[i] = affineInverse(in[i]).
+	/// out may be in. Float matrices use SSE2 when GLM_ARCH includes it,
+	/// whatever their qualifier.
+	///
+	/// @see gtc_matrix_inverse
+	template<typename T, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void affineInverse(mat<4, 4, T, Q> const* in, mat<4, 4, T, Q>* out, std::size_t count);
+
+	/// Inverse transpose of count matrices: out[i] = inverseTranspose(in[i]).
+	/// out may be in. SIMD as for the array affineInverse.
+	///
+	/// @see gtc_matrix_inverse
+	template<typename T, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void inverseTranspose(mat<3, 3, T, Q> const* in, mat<3, 3, T, Q>* out, std::size_t count);
+
+	/// Normal matrices of count model matrices: the inverse transpose of the
+	/// upper 3x3 of each, out[i] = inverseTranspose(mat3(in[i])). SIMD as for
+	/// the array affineInverse.
+	///
+	/// @see gtc_matrix_inverse
+	template<typename T, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void inverseTranspose(mat<4, 4, T, Q> const* in, mat<3, 3, T, Q>* out, std::size_t count);
+
 	/// @}
 }//namespace glm
 
@@ -1,7 +1,71 @@
 /// @ref gtc_matrix_inverse
 
-namespace glm
+namespace glm{
+namespace detail
 {
+	template<typename T, qualifier Q, bool Aligned>
+	struct compute_affineInverse
+	{
+		GLM_FUNC_QUALIFIER static mat<4, 4, T, Q> call(mat<4, 4, T, Q> const& m)
+		{
+			mat<3, 3, T, Q> const Inv(inverse(mat<3, 3, T, Q>(m)));
+
+			return mat<4, 4, T, Q>(
+				vec<4, T, Q>(Inv[0], static_cast<T>(0)),
+				vec<4, T, Q>(Inv[1], static_cast<T>(0)),
+				vec<4, T, Q>(Inv[2], static_cast<T>(0)),
+				vec<4, T, Q>(-Inv * vec<3, T, Q>(m[3]), static_cast<T>(1)));
+		}
+	};
+
+	template<typename T, qualifier Q, bool Aligned>
+	struct compute_inverseTranspose
+	{
+		GLM_FUNC_QUALIFIER static mat<3, 3, T, Q> call(mat<3, 3, T, Q> const& m)
+		{
+			T Determinant =
+				+ m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+				- m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+				+ m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+
+			mat<3, 3, T, Q> Inverse;
+			Inverse[0][0] = + (m[1][1] * m[2][2] - m[2][1] * m[1][2]);
+			Inverse[0][1] = - (m[1][0] * m[2][2] - m[2][0] * m[1][2]);
+			Inverse[0][2] = + (m[1][0] * m[2][1] - m[2][0] * m[1][1]);
+			Inverse[1][0] = - (m[0][1] * m[2][2] - m[2][1] * m[0][2]);
+			Inverse[1][1] = + (m[0][0] * m[2][2] - m[2][0] * m[0][2]);
+			Inverse[1][2] = - (m[0][0] * m[2][1] - m[2][0] * m[0][1]);
+			Inverse[2][0] = + (m[0][1] * m[1][2] - m[1][1] * m[0][2]);
+			Inverse[2][1] = - (m[0][0] * m[1][2] - m[1][0] * m[0][2]);
+			Inverse[2][2] = + (m[0][0] * m[1][1] - m[1][0] * m[0][1]);
+			Inverse /= Determinant;
+
+			return Inverse;
+		}
+	};
+
+	template<typename T, qualifier Q>
+	struct compute_affineInverse_array
+	{
+		GLM_FUNC_QUALIFIER static void call(mat<4, 4, T, Q> const* in, mat<4, 4, T, Q>* out, std::size_t count)
+		{
+			for(std::size_t i = 0; i < count; ++i)
+				out[i] = compute_affineInverse<T, Q, detail::is_aligned<Q>::value>::call(in[i]);
+		}
+	};
+
+	// L is the size of the input matrices, whose upper 3x3 is used
+	template<length_t L, typename T, qualifier Q>
+	struct compute_inverseTranspose_array
+	{
+		GLM_FUNC_QUALIFIER static void call(mat<L, L, T, Q> const* in, mat<3, 3, T, Q>* out, std::size_t count)
+		{
+			for(std::size_t i = 0; i < count; ++i)
+				out[i] = compute_inverseTranspose<T, Q, detail::is_aligned<Q>::value>::call(mat<3, 3, T, Q>(in[i]));
+		}
+	};
+}//namespace detail
+
 	template<typename T, qualifier Q>
 	GLM_FUNC_QUALIFIER mat<3, 3, T, Q> affineInverse(mat<3, 3, T, Q> const& m)
 	{
@@ -16,13 +80,7 @@ namespace glm
 	template<typename T, qualifier Q>
 	GLM_FUNC_QUALIFIER mat<4, 4, T, Q> affineInverse(mat<4, 4, T, Q> const& m)
 	{
-		mat<3, 3, T, Q> const Inv(inverse(mat<3, 3, T, Q>(m)));
-
-		return mat<4, 4, T, Q>(
-			vec<4, T, Q>(Inv[0], static_cast<T>(0)),
-			vec<4, T, Q>(Inv[1], static_cast<T>(0)),
-			vec<4, T, Q>(Inv[2], static_cast<T>(0)),
-			vec<4, T, Q>(-Inv * vec<3, T, Q>(m[3]), static_cast<T>(1)));
+		return detail::compute_affineInverse<T, Q, detail::is_aligned<Q>::value>::call(m);
 	}
 
 	template<typename T, qualifier Q>
@@ -42,24 +100,7 @@ namespace glm
 	template<typename T, qualifier Q>
 	GLM_FUNC_QUALIFIER mat<3, 3, T, Q> inverseTranspose(mat<3, 3, T, Q> const& m)
 	{
-		T Determinant =
-			+ m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
-			- m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
-			+ m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
-
-		mat<3, 3, T, Q> Inverse;
-		Inverse[0][0] = + (m[1][1] * m[2][2] - m[2][1] * m[1][2]);
-		Inverse[0][1] = - (m[1][0] * m[2][2] - m[2][0] * m[1][2]);
-		Inverse[0][2] = + (m[1][0] * m[2][1] - m[2][0] * m[1][1]);
-		Inverse[1][0] = - (m[0][1] * m[2][2] - m[2][1] * m[0][2]);
-		Inverse[1][1] = + (m[0][0] * m[2][2] - m[2][0] * m[0][2]);
-		Inverse[1][2] = - (m[0][0] * m[2][1] - m[2][0] * m[0][1]);
-		Inverse[2][0] = + (m[0][1] * m[1][2] - m[1][1] * m[0][2]);
-		Inverse[2][1] = - (m[0][0] * m[1][2] - m[1][0] * m[0][2]);
-		Inverse[2][2] = + (m[0][0] * m[1][1] - m[1][0] * m[0][1]);
-		Inverse /= Determinant;
-
-		return Inverse;
+		return detail::compute_inverseTranspose<T, Q, detail::is_aligned<Q>::value>::call(m);
 	}
 
 	template<typename T, qualifier Q>
@@ -115,4 +156,26 @@ namespace glm
 
 		return Inverse;
 	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void affineInverse(mat<4, 4, T, Q> const* in, mat<4, 4, T, Q>* out, std::size_t count)
+	{
+		detail::compute_affineInverse_array<T, Q>::call(in, out, count);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void inverseTranspose(mat<3, 3, T, Q> const* in, mat<3, 3, T, Q>* out, std::size_t count)
+	{
+		detail::compute_inverseTranspose_array<3, T, Q>::call(in, out, count);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void inverseTranspose(mat<4, 4, T, Q> const* in, mat<3, 3, T, Q>* out, std::size_t count)
+	{
+		detail::compute_inverseTranspose_array<4, T, Q>::call(in, out, count);
+	}
 }//namespace glm
+
+#if GLM_CONFIG_SIMD == GLM_ENABLE
+#	include "matrix_inverse_simd.inl"
+#endif
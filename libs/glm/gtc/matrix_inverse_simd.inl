@@ -0,0 +1,124 @@
+/// @ref gtc_matrix_inverse
+/// @file glm/gtc/matrix_inverse_simd.inl
+
+#include "../simd/matrix.h"
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+namespace glm{
+namespace detail
+{
+	template<qualifier Q>
+	struct compute_affineInverse<float, Q, true>
+	{
+		GLM_FUNC_QUALIFIER static mat<4, 4, float, Q> call(mat<4, 4, float, Q> const& m)
+		{
+			mat<4, 4, float, Q> Result;
+			glm_mat4_affine_inverse(&m[0].data, &Result[0].data);
+			return Result;
+		}
+	};
+
+	template<qualifier Q>
+	struct compute_inverseTranspose<float, Q, true>
+	{
+		GLM_FUNC_QUALIFIER static mat<3, 3, float, Q> call(mat<3, 3, float, Q> const& m)
+		{
+			mat<3, 3, float, Q> Result;
+			glm_mat3_inverse_transpose(&m[0].data, &Result[0].data);
+			return Result;
+		}
+	};
+
+	// The array versions take any qualifier, so they load and store columns
+	// unaligned. A packed mat3 is 9 floats: its last column is read and
+	// written through the 4 floats ending with it, never past the matrix.
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void columns_loadu(mat<4, 4, float, Q> const& m, glm_vec4 c[], length_t n)
+	{
+		float const* p = &m[0][0];
+		for(length_t i = 0; i < n; ++i)
+			c[i] = _mm_loadu_ps(p + i * 4);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void columns_loadu(mat<3, 3, float, Q> const& m, glm_vec4 c[], length_t)
+	{
+		float const* p = &m[0][0];
+		GLM_IF_CONSTEXPR(sizeof(vec<3, float, Q>) == sizeof(float) * 4)
+		{
+			c[0] = _mm_loadu_ps(p);
+			c[1] = _mm_loadu_ps(p + 4);
+			c[2] = _mm_loadu_ps(p + 8);
+		}
+		else
+		{
+			c[0] = _mm_loadu_ps(p);
+			c[1] = _mm_loadu_ps(p + 3);
+			glm_vec4 const last = _mm_loadu_ps(p + 5);
+			c[2] = _mm_shuffle_ps(last, last, _MM_SHUFFLE(3, 3, 2, 1));
+		}
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void columns_storeu(mat<4, 4, float, Q>& m, glm_vec4 const c[4])
+	{
+		float* p = &m[0][0];
+		for(length_t i = 0; i < 4; ++i)
+			_mm_storeu_ps(p + i * 4, c[i]);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void columns_storeu(mat<3, 3, float, Q>& m, glm_vec4 const c[3])
+	{
+		float* p = &m[0][0];
+		GLM_IF_CONSTEXPR(sizeof(vec<3, float, Q>) == sizeof(float) * 4)
+		{
+			_mm_storeu_ps(p, c[0]);
+			_mm_storeu_ps(p + 4, c[1]);
+			_mm_storeu_ps(p + 8, c[2]);
+		}
+		else
+		{
+			// Each store overwrites the spare float of the one before
+			_mm_storeu_ps(p, c[0]);
+			_mm_storeu_ps(p + 3, c[1]);
+			glm_vec4 const join = _mm_shuffle_ps(c[1], c[2], _MM_SHUFFLE(0, 0, 2, 2));
+			_mm_storeu_ps(p + 5, _mm_shuffle_ps(join, c[2], _MM_SHUFFLE(2, 1, 2, 0)));
+		}
+	}
+
+	template<qualifier Q>
+	struct compute_affineInverse_array<float, Q>
+	{
+		GLM_FUNC_QUALIFIER static void call(mat<4, 4, float, Q> const* in, mat<4, 4, float, Q>* out, std::size_t count)
+		{
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				glm_vec4 m[4], r[4];
+				columns_loadu(in[i], m, 4);
+				glm_mat4_affine_inverse(m, r);
+				columns_storeu(out[i], r);
+			}
+		}
+	};
+
+	template<length_t L, qualifier Q>
+	struct compute_inverseTranspose_array<L, float, Q>
+	{
+		GLM_FUNC_QUALIFIER static void call(mat<L, L, float, Q> const* in, mat<3, 3, float, Q>* out, std::size_t count)
+		{
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				glm_vec4 m[3], r[3];
+				columns_loadu(in[i], m, 3);
+				glm_mat3_inverse_transpose(m, r);
+				columns_storeu(out[i], r);
+			}
+		}
+	};
+}//namespace detail
+}//namespace glm
+
+#endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
@@ -8,12 +8,15 @@
 ///
 /// Include <glm/gtx/color_space_YCoCg.hpp> to use the features of this extension.
 ///
-/// RGB to YCoCg conversions and operations
+/// RGB to YCoCg conversions and operations, and conversion of 8-bit RGBA
+/// images to planar 4:2:0 YCoCg or YCbCr for video encoding
 
 #pragma once
 
 // Dependency:
 #include "../glm.hpp"
+#include "../gtc/type_precision.hpp"
+#include <cstddef>
 
 #ifndef GLM_ENABLE_EXPERIMENTAL
 #	error "GLM: GLM_GTX_color_space_YCoCg is an experimental extension and may change in the future. Use #define GLM_ENABLE_EXPERIMENTAL before including it, if you really want to use it."
@@ -52,6 +55,30 @@ namespace glm
 	GLM_FUNC_DECL vec<3, T, Q> YCoCgR2rgb(
 		vec<3, T, Q> const& YCoCgColor);
 
+	/// Convert an 8-bit RGBA image to planar YCoCg 4:2:0, the integer form of
+	/// rgb2YCoCg: Y at full resolution, Co and Cg averaged over 2x2 blocks
+	/// and offset by 128. Alpha is ignored.
+	///
+	/// @param rgba First row of the image; rows are rgbaStride bytes apart.
+	/// @param flipY Read the rows bottom-up, as glReadPixels returns them.
+	/// @param y width * height bytes.
+	/// @param co, cg (width / 2) * (height / 2) bytes each.
+	///
+	/// width and height must be even. Uses SSE2 when GLM_ARCH includes it;
+	/// the result is identical either way.
+	/// @see gtx_color_space_YCoCg
+	GLM_FUNC_DISCARD_DECL void rgba8ToYCoCg420(
+		uint8 const* rgba, std::size_t rgbaStride, length_t width, length_t height, bool flipY,
+		uint8* y, uint8* co, uint8* cg);
+
+	/// Convert an 8-bit RGBA image to planar YCbCr 4:2:0 with full range
+	/// BT.601 coefficients (JFIF, Y4M's C420jpeg). Parameters as for
+	/// rgba8ToYCoCg420.
+	/// @see gtx_color_space_YCoCg
+	GLM_FUNC_DISCARD_DECL void rgba8ToYCbCr420(
+		uint8 const* rgba, std::size_t rgbaStride, length_t width, length_t height, bool flipY,
+		uint8* y, uint8* cb, uint8* cr);
+
 	/// @}
 }//namespace glm
 
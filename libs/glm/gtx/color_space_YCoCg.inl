@@ -1,5 +1,7 @@
 /// @ref gtx_color_space_YCoCg
 
+#include <cstring>
+
 namespace glm
 {
 	template<typename T, qualifier Q>
@@ -104,4 +106,175 @@ namespace glm
 	{
 		return compute_YCoCgR<T, Q, std::numeric_limits<T>::is_integer>::YCoCgR2rgb(YCoCgRColor);
 	}
+
+namespace detail
+{
+	// One 2x2 block of the 4:2:0 conversion. The SIMD kernels below do the
+	// same integer math eight pixels at a time.
+	struct compute_YCoCg420
+	{
+		static GLM_FUNC_QUALIFIER uint8 luma(int r, int g, int b)
+		{
+			return static_cast<uint8>((r + 2 * g + b + 2) >> 2);
+		}
+
+		// r, g and b are sums over the four pixels of the block
+		static GLM_FUNC_QUALIFIER void chroma(int r, int g, int b, uint8& co, uint8& cg)
+		{
+			co = static_cast<uint8>(((r - b) >> 3) + 128);
+			cg = static_cast<uint8>(((2 * g - r - b) >> 4) + 128);
+		}
+	};
+
+	struct compute_YCbCr420
+	{
+		static GLM_FUNC_QUALIFIER uint8 luma(int r, int g, int b)
+		{
+			return static_cast<uint8>((77 * r + 150 * g + 29 * b + 128) >> 8);
+		}
+
+		static GLM_FUNC_QUALIFIER void chroma(int r, int g, int b, uint8& cb, uint8& cr)
+		{
+			r = (r + 2) >> 2;
+			g = (g + 2) >> 2;
+			b = (b + 2) >> 2;
+			cb = static_cast<uint8>(glm::clamp((-43 * r - 85 * g + 128 * b + 32896) >> 8, 0, 255));
+			cr = static_cast<uint8>(glm::clamp((128 * r - 107 * g - 21 * b + 32896) >> 8, 0, 255));
+		}
+	};
+
+	template<typename convert>
+	GLM_FUNC_QUALIFIER void convert420_scalar(uint8 const* row0, uint8 const* row1, uint8* y0, uint8* y1, uint8* c0, uint8* c1)
+	{
+		int r = 0, g = 0, b = 0;
+		for(length_t i = 0; i < 2; ++i)
+		{
+			y0[i] = convert::luma(row0[i * 4], row0[i * 4 + 1], row0[i * 4 + 2]);
+			y1[i] = convert::luma(row1[i * 4], row1[i * 4 + 1], row1[i * 4 + 2]);
+			r += row0[i * 4] + row1[i * 4];
+			g += row0[i * 4 + 1] + row1[i * 4 + 1];
+			b += row0[i * 4 + 2] + row1[i * 4 + 2];
+		}
+		convert::chroma(r, g, b, *c0, *c1);
+	}
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	// Eight RGBA8 pixels to 16-bit R, G and B lanes
+	GLM_FUNC_QUALIFIER void load_rgb8_sse2(uint8 const* p, __m128i& r, __m128i& g, __m128i& b)
+	{
+		__m128i const a0 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+		__m128i const a1 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + 16));
+		__m128i const mask = _mm_set1_epi32(0xFF);
+		r = _mm_packs_epi32(_mm_and_si128(a0, mask), _mm_and_si128(a1, mask));
+		g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(a0, 8), mask), _mm_and_si128(_mm_srli_epi32(a1, 8), mask));
+		b = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(a0, 16), mask), _mm_and_si128(_mm_srli_epi32(a1, 16), mask));
+	}
+
+	// Sums over 2x2 blocks of two rows of eight 16-bit lanes: four 32-bit lanes
+	GLM_FUNC_QUALIFIER __m128i block_sum_sse2(__m128i row0, __m128i row1)
+	{
+		return _mm_madd_epi16(_mm_add_epi16(row0, row1), _mm_set1_epi16(1));
+	}
+
+	// Two sets of four 32-bit chroma values in [0, 255] to bytes
+	GLM_FUNC_QUALIFIER void store_chroma_sse2(__m128i c0, __m128i c1, uint8* d0, uint8* d1)
+	{
+		__m128i const packed = _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_setzero_si128());
+		int const v0 = _mm_cvtsi128_si32(packed);
+		int const v1 = _mm_cvtsi128_si32(_mm_srli_si128(packed, 4));
+		std::memcpy(d0, &v0, 4);
+		std::memcpy(d1, &v1, 4);
+	}
+
+	GLM_FUNC_QUALIFIER void convert420_sse2(compute_YCoCg420, uint8 const* row0, uint8 const* row1, uint8* y0, uint8* y1, uint8* co, uint8* cg)
+	{
+		__m128i r0, g0, b0, r1, g1, b1;
+		load_rgb8_sse2(row0, r0, g0, b0);
+		load_rgb8_sse2(row1, r1, g1, b1);
+		__m128i const two = _mm_set1_epi16(2);
+		__m128i const l0 = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(r0, b0), _mm_add_epi16(_mm_slli_epi16(g0, 1), two)), 2);
+		__m128i const l1 = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(r1, b1), _mm_add_epi16(_mm_slli_epi16(g1, 1), two)), 2);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(y0), _mm_packus_epi16(l0, l0));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(y1), _mm_packus_epi16(l1, l1));
+
+		__m128i const r = block_sum_sse2(r0, r1);
+		__m128i const g = block_sum_sse2(g0, g1);
+		__m128i const b = block_sum_sse2(b0, b1);
+		__m128i const offset = _mm_set1_epi32(128);
+		__m128i const co4 = _mm_add_epi32(_mm_srai_epi32(_mm_sub_epi32(r, b), 3), offset);
+		__m128i const cg4 = _mm_add_epi32(_mm_srai_epi32(_mm_sub_epi32(_mm_slli_epi32(g, 1), _mm_add_epi32(r, b)), 4), offset);
+		store_chroma_sse2(co4, cg4, co, cg);
+	}
+
+	GLM_FUNC_QUALIFIER void convert420_sse2(compute_YCbCr420, uint8 const* row0, uint8 const* row1, uint8* y0, uint8* y1, uint8* cb, uint8* cr)
+	{
+		__m128i r0, g0, b0, r1, g1, b1;
+		load_rgb8_sse2(row0, r0, g0, b0);
+		load_rgb8_sse2(row1, r1, g1, b1);
+		// 77 * 255 + 150 * 255 + 29 * 255 + 128 still fits 16 unsigned bits
+		__m128i const kr = _mm_set1_epi16(77), kg = _mm_set1_epi16(150), kb = _mm_set1_epi16(29), half = _mm_set1_epi16(128);
+		__m128i const l0 = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(r0, kr), _mm_mullo_epi16(g0, kg)), _mm_add_epi16(_mm_mullo_epi16(b0, kb), half)), 8);
+		__m128i const l1 = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(r1, kr), _mm_mullo_epi16(g1, kg)), _mm_add_epi16(_mm_mullo_epi16(b1, kb), half)), 8);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(y0), _mm_packus_epi16(l0, l0));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(y1), _mm_packus_epi16(l1, l1));
+
+		// Block averages, then (r, g) and (b, 0) pairs for madd
+		__m128i const two = _mm_set1_epi32(2);
+		__m128i const r = _mm_srai_epi32(_mm_add_epi32(block_sum_sse2(r0, r1), two), 2);
+		__m128i const g = _mm_srai_epi32(_mm_add_epi32(block_sum_sse2(g0, g1), two), 2);
+		__m128i const b = _mm_srai_epi32(_mm_add_epi32(block_sum_sse2(b0, b1), two), 2);
+		__m128i const rg = _mm_unpacklo_epi16(_mm_packs_epi32(r, r), _mm_packs_epi32(g, g));
+		__m128i const b_ = _mm_unpacklo_epi16(_mm_packs_epi32(b, b), _mm_setzero_si128());
+		__m128i const bias = _mm_set1_epi32(32896);
+		__m128i const cb4 = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(
+			_mm_madd_epi16(rg, _mm_set_epi16(-85, -43, -85, -43, -85, -43, -85, -43)),
+			_mm_madd_epi16(b_, _mm_set_epi16(0, 128, 0, 128, 0, 128, 0, 128))), bias), 8);
+		__m128i const cr4 = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(
+			_mm_madd_epi16(rg, _mm_set_epi16(-107, 128, -107, 128, -107, 128, -107, 128)),
+			_mm_madd_epi16(b_, _mm_set_epi16(0, -21, 0, -21, 0, -21, 0, -21))), bias), 8);
+		store_chroma_sse2(cb4, cr4, cb, cr);
+	}
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+	template<typename convert>
+	GLM_FUNC_QUALIFIER void convert420(uint8 const* rgba, std::size_t rgbaStride, length_t width, length_t height, bool flipY, uint8* y, uint8* c0, uint8* c1)
+	{
+		std::size_t const w = static_cast<std::size_t>(width);
+		for(length_t j = 0; j < height / 2; ++j)
+		{
+			std::size_t const top = static_cast<std::size_t>(flipY ? height - 1 - 2 * j : 2 * j);
+			uint8 const* row0 = rgba + top * rgbaStride;
+			uint8 const* row1 = flipY ? row0 - rgbaStride : row0 + rgbaStride;
+			uint8* y0 = y + static_cast<std::size_t>(2 * j) * w;
+			uint8* y1 = y0 + w;
+			uint8* d0 = c0 + static_cast<std::size_t>(j) * (w / 2);
+			uint8* d1 = c1 + static_cast<std::size_t>(j) * (w / 2);
+			length_t i = 0;
+#			if GLM_ARCH & GLM_ARCH_SSE2_BIT
+				for(; i + 8 <= width; i += 8)
+					convert420_sse2(convert(), row0 + i * 4, row1 + i * 4, y0 + i, y1 + i, d0 + i / 2, d1 + i / 2);
+#			endif
+			for(; i + 2 <= width; i += 2)
+				convert420_scalar<convert>(row0 + i * 4, row1 + i * 4, y0 + i, y1 + i, d0 + i / 2, d1 + i / 2);
+		}
+	}
+}//namespace detail
+
+	GLM_FUNC_QUALIFIER void rgba8ToYCoCg420
+	(
+		uint8 const* rgba, std::size_t rgbaStride, length_t width, length_t height, bool flipY,
+		uint8* y, uint8* co, uint8* cg
+	)
+	{
+		detail::convert420<detail::compute_YCoCg420>(rgba, rgbaStride, width, height, flipY, y, co, cg);
+	}
+
+	GLM_FUNC_QUALIFIER void rgba8ToYCbCr420
+	(
+		uint8 const* rgba, std::size_t rgbaStride, length_t width, length_t height, bool flipY,
+		uint8* y, uint8* cb, uint8* cr
+	)
+	{
+		detail::convert420<detail::compute_YCbCr420>(rgba, rgbaStride, width, height, flipY, y, cb, cr);
+	}
 }//namespace glm
@@ -1037,4 +1037,49 @@ GLM_FUNC_QUALIFIER void glm_mat4_outerProduct(__m128 const& c, __m128 const& r,
 	out[3] = _mm_mul_ps(c, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3)));
 }
 
+// Cofactors of the upper 3x3 of in[0..2], the w components ignored: out[i] is
+// the cross product of the other two columns, so out is the transposed adjugate.
+// Returns the determinant in every component.
+GLM_FUNC_QUALIFIER glm_vec4 glm_mat3_cofactors(glm_vec4 const in[3], glm_vec4 out[3])
+{
+	glm_vec4 const mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+	glm_vec4 const c0 = _mm_and_ps(in[0], mask);
+	glm_vec4 const c1 = _mm_and_ps(in[1], mask);
+	glm_vec4 const c2 = _mm_and_ps(in[2], mask);
+
+	out[0] = glm_vec4_cross(c1, c2);
+	out[1] = glm_vec4_cross(c2, c0);
+	out[2] = glm_vec4_cross(c0, c1);
+	return glm_vec4_dot(c0, out[0]);
+}
+
+// Inverse transpose of the upper 3x3 of in[0..2], the normal matrix; the w
+// components of out are 0
+GLM_FUNC_QUALIFIER void glm_mat3_inverse_transpose(glm_vec4 const in[3], glm_vec4 out[3])
+{
+	glm_vec4 const det = glm_mat3_cofactors(in, out);
+	glm_vec4 const rcp = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+	out[0] = _mm_mul_ps(out[0], rcp);
+	out[1] = _mm_mul_ps(out[1], rcp);
+	out[2] = _mm_mul_ps(out[2], rcp);
+}
+
+// Inverse of an affine matrix: the upper 3x3 is inverted through its
+// cofactors and the translation moved by the result. The bottom row of in is
+// taken to be (0, 0, 0, 1).
+GLM_FUNC_QUALIFIER void glm_mat4_affine_inverse(glm_vec4 const in[4], glm_vec4 out[4])
+{
+	glm_vec4 rows[4];
+	glm_mat3_inverse_transpose(in, rows);
+	rows[3] = _mm_setzero_ps();
+	glm_mat4_transpose(rows, out);
+
+	glm_vec4 const t = in[3];
+	glm_vec4 const tx = _mm_mul_ps(out[0], _mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0)));
+	glm_vec4 const ty = _mm_mul_ps(out[1], _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1)));
+	glm_vec4 const tz = _mm_mul_ps(out[2], _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2)));
+	out[3] = _mm_sub_ps(_mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f), _mm_add_ps(_mm_add_ps(tx, ty), tz));
+}
+
 #endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
@@ -0,0 +1,70 @@
+#pragma once
+
+// CPU-side mesh data in the renderer's interleaved layout: position (x, y, z)
+// followed by color (r, g, b), 24 bytes per vertex, 32-bit indices.
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+struct Vertex {
+    glm::vec3 position;
+    glm::vec3 color;
+};
+static_assert(sizeof(Vertex) == 6 * sizeof(float), "Vertex must match the interleaved float layout");
+
+// Level of detail: a range of the index buffer
+struct MeshLod {
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    float maxError; // Object-space error of this level, 0 for the full mesh
+};
+
+struct MeshData {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<MeshLod> lods; // Empty means one level covering all indices
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+};
+
+inline void computeBounds(MeshData& mesh) {
+    if (mesh.vertices.empty()) {
+        mesh.boundsMin = mesh.boundsMax = glm::vec3(0.0f);
+        return;
+    }
+    mesh.boundsMin = mesh.boundsMax = mesh.vertices[0].position;
+    for (const Vertex& vertex : mesh.vertices) {
+        mesh.boundsMin = glm::min(mesh.boundsMin, vertex.position);
+        mesh.boundsMax = glm::max(mesh.boundsMax, vertex.position);
+    }
+}
+
+// Bounding sphere around the box center; loose but cheap and stable
+inline void boundingSphere(const glm::vec3& boundsMin, const glm::vec3& boundsMax, glm::vec3& center, float& radius) {
+    center = (boundsMin + boundsMax) * 0.5f;
+    radius = glm::length(boundsMax - center);
+}
+
+// The assignment pyramid: square base on the z = 0 plane, peak at z = 1
+inline MeshData makePyramidMesh() {
+    MeshData mesh;
+    mesh.vertices = {
+        // Position (x, y, z)            Color (r, g, b)
+        { { -0.5f, -0.5f, 0.0f }, { 1.0f, 0.0f, 0.0f } }, // Bottom left - Red
+        { {  0.5f, -0.5f, 0.0f }, { 0.0f, 1.0f, 0.0f } }, // Bottom right - Green
+        { {  0.5f,  0.5f, 0.0f }, { 0.0f, 0.0f, 1.0f } }, // Top right - Blue
+        { { -0.5f,  0.5f, 0.0f }, { 1.0f, 1.0f, 0.0f } }, // Top left - Yellow
+        { {  0.0f,  0.0f, 1.0f }, { 1.0f, 0.5f, 0.2f } }  // Peak - Orange
+    };
+    mesh.indices = {
+        0, 1, 2,  // Base triangle 1
+        2, 3, 0,  // Base triangle 2
+        0, 1, 4,  // Front face
+        1, 2, 4,  // Right face
+        2, 3, 4,  // Back face
+        3, 0, 4   // Left face
+    };
+    computeBounds(mesh);
+    return mesh;
+}
@@ -0,0 +1,132 @@
+// Mesh converter: writes meshes into the binary .pmesh container that
+// A2_Comp371 --mesh maps and uploads without parsing.
+//
+// Usage: mesh_convert [--format float|snorm16|half] [--no-optimize] <input> <output.pmesh>
+//   input:  "pyramid" for the built-in assignment pyramid,
+//           "sierpinski:DEPTH[:SIDES]" for a generated Sierpinski pyramid,
+//           an .obj/.ply file, or a float .pmesh file to re-encode
+//   format: vertex layout to write; snorm16 and half write 16-byte quantized
+//           vertices (see vertex_quantize.h), float the 24-byte Vertex layout
+// Triangles and vertices are reordered for the vertex cache, overdraw and
+// fetch locality (see mesh_optimize.h) unless --no-optimize is given.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "job_system.h"
+#include "mesh.h"
+#include "mesh_format.h"
+#include "mesh_import.h"
+#include "mesh_optimize.h"
+#include "pyramid_gen.h"
+#include "vertex_quantize.h"
+
+bool loadInput(const std::string& input, JobSystem& jobs, MeshData& mesh, std::string& error) {
+    if (input == "pyramid") {
+        mesh = makePyramidMesh();
+        return true;
+    }
+    if (input.compare(0, 11, "sierpinski:") == 0) {
+        PyramidGenParams params;
+        size_t colon = input.find(':', 11);
+        params.depth = static_cast<uint32_t>(std::atoi(input.c_str() + 11));
+        if (colon != std::string::npos)
+            params.sides = static_cast<uint32_t>(std::atoi(input.c_str() + colon + 1));
+        if (!validPyramidParams(params)) {
+            error = "invalid depth or side count";
+            return false;
+        }
+        mesh = generateSierpinski(params, jobs);
+        return true;
+    }
+    if (hasExtension(input, ".pmesh")) {
+        MappedFile file;
+        MeshFileView view;
+        error = "cannot open file";
+        return file.open(input) && openMeshFile(file, view, error) && readMeshData(view, mesh, error);
+    }
+    return importMeshFile(input, jobs, mesh, error);
+}
+
+bool parseFormat(const std::string& name, VertexFormat& format) {
+    if (name == "float")
+        format = VertexFormat::PositionColorF32;
+    else if (name == "snorm16")
+        format = VertexFormat::QuantizedSnorm16;
+    else if (name == "half")
+        format = VertexFormat::QuantizedHalf;
+    else
+        return false;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    VertexFormat format = VertexFormat::PositionColorF32;
+    bool optimize = true;
+    std::vector<std::string> paths;
+    bool validArguments = true;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--format" && i + 1 < argc)
+            validArguments = parseFormat(argv[++i], format) && validArguments;
+        else if (arg == "--no-optimize")
+            optimize = false;
+        else
+            paths.push_back(arg);
+    }
+    if (!validArguments || paths.size() != 2) {
+        std::cerr << "Usage: mesh_convert [--format float|snorm16|half] [--no-optimize] <input> <output.pmesh>"
+            << std::endl;
+        std::cerr << "  input: \"pyramid\", \"sierpinski:DEPTH[:SIDES]\", an .obj/.ply file or a float .pmesh"
+            << std::endl;
+        return 1;
+    }
+    std::string input = paths[0];
+    std::string output = paths[1];
+
+    JobSystem jobs;
+    MeshData mesh;
+    std::string error;
+    auto start = std::chrono::steady_clock::now();
+    if (!loadInput(input, jobs, mesh, error)) {
+        std::cerr << "Failed to load " << input << ": " << error << std::endl;
+        return 1;
+    }
+    double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Loaded " << input << " in " << loadSeconds << " s on " << jobs.workerCount() << " threads"
+        << std::endl;
+    if (optimize) {
+        MeshOptimizeReport report = optimizeMesh(mesh);
+        std::cout << "Optimized: ACMR " << report.before.acmr << " -> " << report.after.acmr << ", ATVR "
+            << report.before.atvr << " -> " << report.after.atvr << ", " << report.clusters
+            << " overdraw clusters" << std::endl;
+    }
+    bool written;
+    if (isQuantized(format)) {
+        std::vector<QuantizedVertex> packed;
+        QuantizationError quantization = quantizeMesh(mesh, format, jobs, packed);
+        std::cout << "Quantized to " << sizeof(QuantizedVertex) << " bytes/vertex (was " << sizeof(Vertex)
+            << "), max position error " << quantization.maxPosition << ", max normal error "
+            << quantization.maxNormalDegrees << " degrees" << std::endl;
+        if (fitsIndex16(mesh.vertices.size())) {
+            std::vector<uint16_t> indices = narrowIndices(mesh.indices);
+            written = writeMeshFile(output, format, sizeof(QuantizedVertex), packed.data(), packed.size(),
+                indices.data(), sizeof(uint16_t), indices.size(), mesh.lods, mesh.boundsMin, mesh.boundsMax);
+        } else {
+            written = writeMeshFile(output, format, sizeof(QuantizedVertex), packed.data(), packed.size(),
+                mesh.indices.data(), sizeof(uint32_t), mesh.indices.size(), mesh.lods, mesh.boundsMin,
+                mesh.boundsMax);
+        }
+    } else {
+        written = writeMeshFile(output, mesh);
+    }
+    if (!written) {
+        std::cerr << "Failed to write " << output << std::endl;
+        return 1;
+    }
+    std::cout << output << ": " << mesh.vertices.size() << " vertices, " << mesh.indices.size() / 3
+        << " triangles, " << (fitsIndex16(mesh.vertices.size()) ? 16 : 32) << "-bit indices" << std::endl;
+    return 0;
+}
@@ -0,0 +1,369 @@
+#pragma once
+
+// Versioned binary mesh container (.pmesh) and a read-only memory mapping to
+// load it without parsing or copying.
+//
+// Layout (little endian, every blob starts on a MESH_BLOB_ALIGNMENT boundary):
+//   MeshFileHeader
+//   MeshFileLod[lodCount]
+//   vertex blob: vertexCount * vertexStride bytes
+//   index blob:  indexCount * indexSize bytes
+//
+// The vertex and index blobs are exactly what the GPU buffers hold, so a
+// loader can hand pointers into the mapping straight to glBufferStorage.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "mesh.h"
+#include "mesh_optimize.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const char MESH_FILE_MAGIC[4] = { 'P', 'M', 'S', 'H' };
+const uint32_t MESH_FILE_VERSION = 1;
+const uint64_t MESH_BLOB_ALIGNMENT = 256;
+
+// Vertex layouts a mesh file can store
+enum class VertexFormat : uint32_t {
+    PositionColorF32 = 0, // vec3 position, vec3 color (struct Vertex)
+    QuantizedSnorm16 = 1, // QuantizedVertex, snorm16 positions relative to the bounds
+    QuantizedHalf = 2     // QuantizedVertex, half float positions
+};
+
+// Bytes per vertex of a format, 0 for values this build does not know
+constexpr uint32_t vertexFormatStride(uint32_t format) {
+    switch (static_cast<VertexFormat>(format)) {
+    case VertexFormat::PositionColorF32:
+        return sizeof(Vertex);
+    case VertexFormat::QuantizedSnorm16:
+    case VertexFormat::QuantizedHalf:
+        return 16; // QuantizedVertex, see vertex_quantize.h
+    }
+    return 0;
+}
+
+// Whether [offset, offset + bytes) lies inside a file of `size` bytes, without overflowing
+inline bool blobInFile(uint64_t offset, uint64_t bytes, uint64_t size) {
+    return offset <= size && bytes <= size - offset;
+}
+
+// Largest of `count` indices; blobs are aligned, so they are read in place
+template <typename Index>
+inline uint32_t maxIndexOf(const uint8_t* data, uint64_t count) {
+    const Index* indices = reinterpret_cast<const Index*>(data);
+    Index largest = 0;
+    for (uint64_t i = 0; i < count; ++i)
+        largest = std::max(largest, indices[i]);
+    return largest;
+}
+
+struct MeshFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t vertexFormat;
+    uint32_t vertexStride;
+    uint32_t indexSize;   // 2 or 4 bytes
+    uint32_t lodCount;
+    uint64_t vertexCount;
+    uint64_t indexCount;
+    uint64_t lodOffset;   // Byte offsets from the start of the file
+    uint64_t vertexOffset;
+    uint64_t indexOffset;
+    float boundsMin[3];
+    float boundsMax[3];
+    float boundsSphere[4]; // Center xyz, radius
+    uint32_t reserved[6];
+};
+static_assert(sizeof(MeshFileHeader) == 128, "MeshFileHeader is part of the file format");
+
+struct MeshFileLod {
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    float maxError;
+    uint32_t reserved;
+};
+static_assert(sizeof(MeshFileLod) == 16, "MeshFileLod is part of the file format");
+
+inline uint64_t alignBlob(uint64_t offset) {
+    return (offset + MESH_BLOB_ALIGNMENT - 1) & ~(MESH_BLOB_ALIGNMENT - 1);
+}
+
+// Read-only mapping of a whole file
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            close();
+            return false;
+        }
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            close();
+            return false;
+        }
+        data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        size = static_cast<size_t>(fileSize.QuadPart);
+#else
+        descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0)
+            return false;
+        struct stat status;
+        if (fstat(descriptor, &status) != 0 || status.st_size == 0) {
+            close();
+            return false;
+        }
+        size = static_cast<size_t>(status.st_size);
+        void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        data = address == MAP_FAILED ? nullptr : static_cast<const uint8_t*>(address);
+        if (data) { // The whole file is about to be streamed to the GPU; the advice values are not flags
+            madvise(address, size, MADV_SEQUENTIAL);
+            madvise(address, size, MADV_WILLNEED);
+        }
+#endif
+        if (!data) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (data)
+            UnmapViewOfFile(data);
+        if (mapping)
+            CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (data)
+            munmap(const_cast<uint8_t*>(data), size);
+        if (descriptor >= 0)
+            ::close(descriptor);
+        descriptor = -1;
+#endif
+        data = nullptr;
+        size = 0;
+    }
+
+    const uint8_t* bytes() const { return data; }
+    size_t byteSize() const { return size; }
+
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int descriptor = -1;
+#endif
+};
+
+// Validated view into a mapped mesh file; pointers stay valid while the
+// MappedFile is open
+struct MeshFileView {
+    const MeshFileHeader* header = nullptr;
+    const MeshFileLod* lods = nullptr;
+    const uint8_t* vertexData = nullptr;
+    const uint8_t* indexData = nullptr;
+    uint64_t vertexBytes = 0;
+    uint64_t indexBytes = 0;
+};
+
+inline bool openMeshFile(const MappedFile& file, MeshFileView& view, std::string& error) {
+    const uint8_t* data = file.bytes();
+    uint64_t size = file.byteSize();
+    if (!data || size < sizeof(MeshFileHeader)) {
+        error = "file too small";
+        return false;
+    }
+    const MeshFileHeader* header = reinterpret_cast<const MeshFileHeader*>(data);
+    if (std::memcmp(header->magic, MESH_FILE_MAGIC, 4) != 0) {
+        error = "not a mesh file";
+        return false;
+    }
+    if (header->version != MESH_FILE_VERSION) {
+        error = "unsupported mesh file version " + std::to_string(header->version);
+        return false;
+    }
+    if (header->indexSize != 2 && header->indexSize != 4) {
+        error = "invalid index size";
+        return false;
+    }
+    uint32_t stride = vertexFormatStride(header->vertexFormat);
+    if (stride == 0) {
+        error = "unknown vertex format " + std::to_string(header->vertexFormat);
+        return false;
+    }
+    if (header->vertexStride != stride) {
+        error = "vertex stride " + std::to_string(header->vertexStride) + " does not match the vertex format";
+        return false;
+    }
+    // Blobs are read in place, so they must keep the alignment the writer gave them
+    if (header->lodOffset % MESH_BLOB_ALIGNMENT != 0 || header->vertexOffset % MESH_BLOB_ALIGNMENT != 0 ||
+        header->indexOffset % MESH_BLOB_ALIGNMENT != 0) {
+        error = "misaligned mesh blob";
+        return false;
+    }
+    // Counts larger than the file would overflow the byte sizes
+    if (header->vertexCount > size / stride || header->indexCount > size / header->indexSize) {
+        error = "truncated mesh file";
+        return false;
+    }
+    uint64_t vertexBytes = header->vertexCount * stride;
+    uint64_t indexBytes = header->indexCount * header->indexSize;
+    uint64_t lodBytes = uint64_t(header->lodCount) * sizeof(MeshFileLod);
+    if (!blobInFile(header->lodOffset, lodBytes, size) || !blobInFile(header->vertexOffset, vertexBytes, size) ||
+        !blobInFile(header->indexOffset, indexBytes, size)) {
+        error = "truncated mesh file";
+        return false;
+    }
+    view.header = header;
+    view.lods = reinterpret_cast<const MeshFileLod*>(data + header->lodOffset);
+    view.vertexData = data + header->vertexOffset;
+    view.indexData = data + header->indexOffset;
+    view.vertexBytes = vertexBytes;
+    view.indexBytes = indexBytes;
+    for (uint32_t i = 0; i < header->lodCount; ++i) {
+        if (uint64_t(view.lods[i].firstIndex) + view.lods[i].indexCount > header->indexCount) {
+            error = "LOD outside the index blob";
+            return false;
+        }
+    }
+    // Meshlet building and the GPU index buffer use the indices unchecked
+    if (header->indexCount > 0) {
+        uint32_t largest = header->indexSize == 2 ? maxIndexOf<uint16_t>(view.indexData, header->indexCount)
+                                                  : maxIndexOf<uint32_t>(view.indexData, header->indexCount);
+        if (largest >= header->vertexCount) {
+            error = "index " + std::to_string(largest) + " outside the " + std::to_string(header->vertexCount) +
+                " vertices";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Write vertex/index blobs that are already in their GPU layout
+inline bool writeMeshFile(const std::string& path, VertexFormat format, uint32_t vertexStride,
+    const void* vertices, uint64_t vertexCount, const void* indices, uint32_t indexSize, uint64_t indexCount,
+    const std::vector<MeshLod>& lods, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    std::vector<MeshFileLod> fileLods;
+    for (const MeshLod& lod : lods)
+        fileLods.push_back({ lod.firstIndex, lod.indexCount, lod.maxError, 0 });
+    if (fileLods.empty())
+        fileLods.push_back({ 0, static_cast<uint32_t>(indexCount), 0.0f, 0 });
+
+    MeshFileHeader header = {};
+    std::memcpy(header.magic, MESH_FILE_MAGIC, 4);
+    header.version = MESH_FILE_VERSION;
+    header.vertexFormat = static_cast<uint32_t>(format);
+    header.vertexStride = vertexStride;
+    header.indexSize = indexSize;
+    header.lodCount = static_cast<uint32_t>(fileLods.size());
+    header.vertexCount = vertexCount;
+    header.indexCount = indexCount;
+    header.lodOffset = alignBlob(sizeof(MeshFileHeader));
+    header.vertexOffset = alignBlob(header.lodOffset + fileLods.size() * sizeof(MeshFileLod));
+    header.indexOffset = alignBlob(header.vertexOffset + vertexCount * vertexStride);
+    glm::vec3 center;
+    float radius;
+    boundingSphere(boundsMin, boundsMax, center, radius);
+    for (int i = 0; i < 3; ++i) {
+        header.boundsMin[i] = boundsMin[i];
+        header.boundsMax[i] = boundsMax[i];
+        header.boundsSphere[i] = center[i];
+    }
+    header.boundsSphere[3] = radius;
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    auto writeAt = [&file](uint64_t offset, const void* data, uint64_t bytes) {
+        static const char zeros[MESH_BLOB_ALIGNMENT] = {};
+        uint64_t position = static_cast<uint64_t>(file.tellp());
+        while (position < offset) {
+            uint64_t padding = std::min<uint64_t>(offset - position, MESH_BLOB_ALIGNMENT);
+            file.write(zeros, static_cast<std::streamsize>(padding));
+            position += padding;
+        }
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    };
+    writeAt(0, &header, sizeof(header));
+    writeAt(header.lodOffset, fileLods.data(), fileLods.size() * sizeof(MeshFileLod));
+    writeAt(header.vertexOffset, vertices, vertexCount * vertexStride);
+    writeAt(header.indexOffset, indices, indexCount * indexSize);
+    return static_cast<bool>(file);
+}
+
+// Float vertices; indices are stored as 16-bit when the vertex count allows
+inline bool writeMeshFile(const std::string& path, const MeshData& mesh) {
+    if (fitsIndex16(mesh.vertices.size())) {
+        std::vector<uint16_t> indices = narrowIndices(mesh.indices);
+        return writeMeshFile(path, VertexFormat::PositionColorF32, sizeof(Vertex), mesh.vertices.data(),
+            mesh.vertices.size(), indices.data(), sizeof(uint16_t), indices.size(), mesh.lods,
+            mesh.boundsMin, mesh.boundsMax);
+    }
+    return writeMeshFile(path, VertexFormat::PositionColorF32, sizeof(Vertex), mesh.vertices.data(),
+        mesh.vertices.size(), mesh.indices.data(), sizeof(uint32_t), mesh.indices.size(), mesh.lods,
+        mesh.boundsMin, mesh.boundsMax);
+}
+
+// Copy a PositionColorF32 file back into MeshData, e.g. to convert it again
+inline bool readMeshData(const MeshFileView& view, MeshData& mesh, std::string& error) {
+    const MeshFileHeader& header = *view.header;
+    if (header.vertexFormat != static_cast<uint32_t>(VertexFormat::PositionColorF32) ||
+        header.vertexStride != sizeof(Vertex)) {
+        error = "only float meshes can be converted again";
+        return false;
+    }
+    mesh.vertices.resize(header.vertexCount);
+    std::memcpy(mesh.vertices.data(), view.vertexData, view.vertexBytes);
+    mesh.indices.resize(header.indexCount);
+    for (uint64_t i = 0; i < header.indexCount; ++i) {
+        if (header.indexSize == 2) {
+            uint16_t index;
+            std::memcpy(&index, view.indexData + i * 2, 2);
+            mesh.indices[i] = index;
+        } else {
+            std::memcpy(&mesh.indices[i], view.indexData + i * 4, 4);
+        }
+    }
+    mesh.lods.clear();
+    for (uint32_t i = 0; i < header.lodCount; ++i)
+        mesh.lods.push_back({ view.lods[i].firstIndex, view.lods[i].indexCount, view.lods[i].maxError });
+    mesh.boundsMin = glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    mesh.boundsMax = glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+    return true;
+}
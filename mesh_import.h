@@ -0,0 +1,850 @@
+#pragma once
+
+// Streaming, parallel OBJ and PLY (ASCII and binary) importers.
+//
+// Files are read in blocks of ImportOptions::blockBytes, so the text itself
+// is never held in memory as a whole. Each block is cut at line breaks into
+// one piece per worker, the pieces are parsed on the job system with
+// std::from_chars, and the results are appended in file order. At the end
+// vertices are deduplicated into the renderer's position/color layout.
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "job_system.h"
+#include "mesh.h"
+
+struct ImportOptions {
+    size_t blockBytes = 32u << 20; // Bytes of file data held in memory at once
+};
+
+namespace importdetail {
+
+// Geometry as read from the file, before deduplication
+struct RawGeometry {
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> colors; // Same size as positions; x < 0 means "no color"
+    std::vector<uint32_t> triangles; // Position indices, 3 per triangle
+    bool anyColor = false;
+};
+
+inline bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+inline const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && isSpace(*p))
+        ++p;
+    return p;
+}
+
+inline const char* lineEnd(const char* p, const char* end) {
+    const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+    return newline ? static_cast<const char*>(newline) : end;
+}
+
+inline bool parseFloat(const char*& p, const char* end, float& value) {
+    p = skipSpaces(p, end);
+    if (p < end && *p == '+')
+        ++p;
+    std::from_chars_result result = std::from_chars(p, end, value);
+    if (result.ec != std::errc())
+        return false;
+    p = result.ptr;
+    return true;
+}
+
+inline bool parseFloat(const char*& p, const char* end, double& value) {
+    p = skipSpaces(p, end);
+    if (p < end && *p == '+')
+        ++p;
+    std::from_chars_result result = std::from_chars(p, end, value);
+    if (result.ec != std::errc())
+        return false;
+    p = result.ptr;
+    return true;
+}
+
+inline bool parseInt(const char*& p, const char* end, int64_t& value) {
+    p = skipSpaces(p, end);
+    if (p < end && *p == '+')
+        ++p;
+    std::from_chars_result result = std::from_chars(p, end, value);
+    if (result.ec != std::errc())
+        return false;
+    p = result.ptr;
+    return true;
+}
+
+// Split [begin, end) into up to `parts` ranges that end on line breaks
+inline std::vector<std::pair<const char*, const char*>> splitLines(const char* begin, const char* end, size_t parts) {
+    std::vector<std::pair<const char*, const char*>> ranges;
+    size_t target = std::max<size_t>(1, static_cast<size_t>(end - begin) / std::max<size_t>(1, parts));
+    const char* start = begin;
+    while (start < end) {
+        const char* stop = start + std::min(target, static_cast<size_t>(end - start));
+        stop = stop < end ? lineEnd(stop, end) : end;
+        if (stop < end)
+            ++stop;
+        ranges.push_back({ start, stop });
+        start = stop;
+    }
+    return ranges;
+}
+
+// Reads a stream in blocks that only ever contain whole lines
+class LineBlockReader {
+public:
+    LineBlockReader(std::istream& stream, size_t blockBytes) : in(stream), blockSize(std::max<size_t>(blockBytes, 4096)) {}
+
+    bool next(std::vector<char>& block) {
+        block.assign(carry.begin(), carry.end());
+        carry.clear();
+        while (in) {
+            size_t old = block.size();
+            block.resize(old + blockSize);
+            in.read(block.data() + old, static_cast<std::streamsize>(blockSize));
+            block.resize(old + static_cast<size_t>(in.gcount()));
+            if (!in)
+                break; // End of file: the last line may lack a newline
+            auto lastNewline = std::find(block.rbegin(), block.rend(), '\n');
+            if (lastNewline != block.rend()) {
+                size_t keep = static_cast<size_t>(block.rend() - lastNewline);
+                carry.assign(block.begin() + keep, block.end());
+                block.resize(keep);
+                break;
+            }
+            // A single line longer than the block: keep reading
+        }
+        return !block.empty();
+    }
+
+private:
+    std::istream& in;
+    size_t blockSize;
+    std::vector<char> carry;
+};
+
+// Exact-bit vertex key for deduplication
+struct VertexKey {
+    uint32_t bits[6];
+    bool operator==(const VertexKey& other) const { return std::memcmp(bits, other.bits, sizeof(bits)) == 0; }
+};
+
+struct VertexKeyHash {
+    size_t operator()(const VertexKey& key) const {
+        uint64_t hash = 1469598103934665603ull; // FNV-1a
+        for (uint32_t word : key.bits) {
+            hash ^= word;
+            hash *= 1099511628211ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+// Merge identical position/color pairs and drop unreferenced positions.
+// Files without any vertex color get a gradient over their bounds so the
+// shape stays readable with the unlit vertex-color shader.
+inline void buildMesh(RawGeometry& raw, MeshData& mesh) {
+    glm::vec3 boundsMin(0.0f), boundsMax(0.0f);
+    if (!raw.positions.empty()) {
+        boundsMin = boundsMax = raw.positions[0];
+        for (const glm::vec3& position : raw.positions) {
+            boundsMin = glm::min(boundsMin, position);
+            boundsMax = glm::max(boundsMax, position);
+        }
+    }
+    glm::vec3 extent = glm::max(boundsMax - boundsMin, glm::vec3(1e-20f));
+
+    mesh.vertices.clear();
+    mesh.indices.clear();
+    mesh.lods.clear();
+    mesh.indices.reserve(raw.triangles.size());
+    std::vector<uint32_t> remap(raw.positions.size(), ~0u);
+    std::unordered_map<VertexKey, uint32_t, VertexKeyHash> unique;
+    unique.reserve(raw.positions.size());
+    for (uint32_t index : raw.triangles) {
+        if (remap[index] == ~0u) {
+            Vertex vertex;
+            vertex.position = raw.positions[index];
+            vertex.color = raw.colors[index];
+            if (vertex.color.x < 0.0f)
+                vertex.color = raw.anyColor ? glm::vec3(1.0f) : (vertex.position - boundsMin) / extent;
+            VertexKey key;
+            std::memcpy(key.bits, &vertex, sizeof(key.bits));
+            auto inserted = unique.emplace(key, static_cast<uint32_t>(mesh.vertices.size()));
+            if (inserted.second)
+                mesh.vertices.push_back(vertex);
+            remap[index] = inserted.first->second;
+        }
+        mesh.indices.push_back(remap[index]);
+    }
+    computeBounds(mesh);
+}
+
+// ---------------------------------------------------------------- OBJ
+
+// Relative (negative) face indices are resolved against the position count
+// at the start of the piece once pieces are merged
+const int64_t OBJ_RELATIVE_BIAS = int64_t(1) << 62;
+
+struct ObjPiece {
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> colors;
+    std::vector<int64_t> corners; // 3 per triangle
+    bool anyColor = false;
+    bool failed = false;
+    std::string error;
+};
+
+inline void parseObjPiece(const char* p, const char* end, ObjPiece& piece) {
+    std::vector<int64_t> polygon;
+    while (p < end) {
+        const char* stop = lineEnd(p, end);
+        const char* cursor = skipSpaces(p, stop);
+        if (stop - cursor >= 2 && cursor[0] == 'v' && isSpace(cursor[1])) {
+            cursor += 2;
+            glm::vec3 position, color(-1.0f);
+            if (!parseFloat(cursor, stop, position.x) || !parseFloat(cursor, stop, position.y) ||
+                !parseFloat(cursor, stop, position.z)) {
+                piece.failed = true;
+                piece.error = "malformed vertex: " + std::string(p, stop);
+                return;
+            }
+            // Optional "x y z r g b" vertex colors
+            const char* colorCursor = cursor;
+            if (parseFloat(colorCursor, stop, color.r) && parseFloat(colorCursor, stop, color.g) &&
+                parseFloat(colorCursor, stop, color.b))
+                piece.anyColor = true;
+            else
+                color = glm::vec3(-1.0f);
+            piece.positions.push_back(position);
+            piece.colors.push_back(color);
+        } else if (stop - cursor >= 2 && cursor[0] == 'f' && isSpace(cursor[1])) {
+            cursor += 2;
+            polygon.clear();
+            int64_t index;
+            while (parseInt(cursor, stop, index)) {
+                if (index == 0) {
+                    piece.failed = true;
+                    piece.error = "face index 0";
+                    return;
+                }
+                // Before the bias below, which would take a huge index for a relative one
+                if (index > int64_t(UINT32_MAX) + 1 || index < -int64_t(UINT32_MAX) - 1) {
+                    piece.failed = true;
+                    piece.error = "face index out of range: " + std::string(p, stop);
+                    return;
+                }
+                int64_t local = static_cast<int64_t>(piece.positions.size());
+                polygon.push_back(index > 0 ? index - 1 : OBJ_RELATIVE_BIAS + local + index);
+                while (cursor < stop && !isSpace(*cursor)) // Skip "/vt/vn"
+                    ++cursor;
+            }
+            for (size_t i = 2; i < polygon.size(); ++i) {
+                piece.corners.push_back(polygon[0]);
+                piece.corners.push_back(polygon[i - 1]);
+                piece.corners.push_back(polygon[i]);
+            }
+        }
+        p = stop < end ? stop + 1 : end;
+    }
+}
+
+} // namespace importdetail
+
+inline bool importObj(const std::string& path, JobSystem& jobs, MeshData& mesh, std::string& error,
+    const ImportOptions& options = ImportOptions()) {
+    using namespace importdetail;
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    RawGeometry raw;
+    LineBlockReader reader(file, options.blockBytes);
+    std::vector<char> block;
+    while (reader.next(block)) {
+        auto ranges = splitLines(block.data(), block.data() + block.size(), jobs.workerCount() * 4);
+        std::vector<ObjPiece> pieces(ranges.size());
+        jobs.parallelFor("import obj", 0, ranges.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                parseObjPiece(ranges[i].first, ranges[i].second, pieces[i]);
+        });
+        for (ObjPiece& piece : pieces) {
+            if (piece.failed) {
+                error = piece.error;
+                return false;
+            }
+            int64_t base = static_cast<int64_t>(raw.positions.size());
+            raw.positions.insert(raw.positions.end(), piece.positions.begin(), piece.positions.end());
+            raw.colors.insert(raw.colors.end(), piece.colors.begin(), piece.colors.end());
+            raw.anyColor = raw.anyColor || piece.anyColor;
+            for (int64_t corner : piece.corners) {
+                int64_t resolved = corner >= OBJ_RELATIVE_BIAS / 2 ? corner - OBJ_RELATIVE_BIAS + base : corner;
+                // Forward references are checked once every position is known
+                if (resolved < 0 || resolved > UINT32_MAX) {
+                    error = "face index out of range";
+                    return false;
+                }
+                raw.triangles.push_back(static_cast<uint32_t>(resolved));
+            }
+        }
+    }
+    for (uint32_t index : raw.triangles) {
+        if (index >= raw.positions.size()) {
+            error = "face index out of range";
+            return false;
+        }
+    }
+    buildMesh(raw, mesh);
+    return true;
+}
+
+// ---------------------------------------------------------------- PLY
+
+namespace importdetail {
+
+enum class PlyType { Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64, Invalid };
+
+inline PlyType plyType(const std::string& name) {
+    if (name == "char" || name == "int8") return PlyType::Int8;
+    if (name == "uchar" || name == "uint8") return PlyType::UInt8;
+    if (name == "short" || name == "int16") return PlyType::Int16;
+    if (name == "ushort" || name == "uint16") return PlyType::UInt16;
+    if (name == "int" || name == "int32") return PlyType::Int32;
+    if (name == "uint" || name == "uint32") return PlyType::UInt32;
+    if (name == "float" || name == "float32") return PlyType::Float32;
+    if (name == "double" || name == "float64") return PlyType::Float64;
+    return PlyType::Invalid;
+}
+
+inline size_t plyTypeSize(PlyType type) {
+    switch (type) {
+    case PlyType::Int8: case PlyType::UInt8: return 1;
+    case PlyType::Int16: case PlyType::UInt16: return 2;
+    case PlyType::Int32: case PlyType::UInt32: case PlyType::Float32: return 4;
+    case PlyType::Float64: return 8;
+    default: return 0;
+    }
+}
+
+inline double readPlyScalar(const uint8_t* data, PlyType type, bool bigEndian) {
+    uint8_t bytes[8];
+    size_t size = plyTypeSize(type);
+    for (size_t i = 0; i < size; ++i)
+        bytes[i] = data[bigEndian ? size - 1 - i : i];
+    switch (type) {
+    case PlyType::Int8: return static_cast<int8_t>(bytes[0]);
+    case PlyType::UInt8: return bytes[0];
+    case PlyType::Int16: { int16_t v; std::memcpy(&v, bytes, 2); return v; }
+    case PlyType::UInt16: { uint16_t v; std::memcpy(&v, bytes, 2); return v; }
+    case PlyType::Int32: { int32_t v; std::memcpy(&v, bytes, 4); return v; }
+    case PlyType::UInt32: { uint32_t v; std::memcpy(&v, bytes, 4); return v; }
+    case PlyType::Float32: { float v; std::memcpy(&v, bytes, 4); return v; }
+    case PlyType::Float64: { double v; std::memcpy(&v, bytes, 8); return v; }
+    default: return 0.0;
+    }
+}
+
+struct PlyProperty {
+    std::string name;
+    PlyType type = PlyType::Invalid;
+    bool isList = false;
+    PlyType countType = PlyType::Invalid;
+};
+
+struct PlyElement {
+    std::string name;
+    uint64_t count = 0;
+    std::vector<PlyProperty> properties;
+    size_t fixedSize = 0; // Bytes per binary record, 0 if it has a list property
+};
+
+struct PlyHeader {
+    enum class Format { Ascii, BinaryLittleEndian, BinaryBigEndian } format = Format::Ascii;
+    std::vector<PlyElement> elements;
+};
+
+inline bool readPlyHeader(std::istream& in, PlyHeader& header, std::string& error) {
+    std::string line;
+    if (!std::getline(in, line) || line.compare(0, 3, "ply") != 0) {
+        error = "not a PLY file";
+        return false;
+    }
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        std::istringstream words(line);
+        std::string keyword;
+        words >> keyword;
+        if (keyword == "format") {
+            std::string format;
+            words >> format;
+            if (format == "ascii") header.format = PlyHeader::Format::Ascii;
+            else if (format == "binary_little_endian") header.format = PlyHeader::Format::BinaryLittleEndian;
+            else if (format == "binary_big_endian") header.format = PlyHeader::Format::BinaryBigEndian;
+            else {
+                error = "unknown PLY format " + format;
+                return false;
+            }
+        } else if (keyword == "element") {
+            PlyElement element;
+            if (!(words >> element.name >> element.count)) {
+                error = "bad PLY element line: " + line;
+                return false;
+            }
+            header.elements.push_back(element);
+        } else if (keyword == "property") {
+            if (header.elements.empty()) {
+                error = "PLY property outside an element";
+                return false;
+            }
+            PlyProperty property;
+            std::string type;
+            words >> type;
+            if (type == "list") {
+                std::string countType, itemType;
+                words >> countType >> itemType;
+                property.isList = true;
+                property.countType = plyType(countType);
+                property.type = plyType(itemType);
+                if (property.countType == PlyType::Invalid) {
+                    error = "unknown PLY type " + countType;
+                    return false;
+                }
+            } else {
+                property.type = plyType(type);
+            }
+            words >> property.name;
+            if (property.type == PlyType::Invalid) {
+                error = "unknown PLY type in: " + line;
+                return false;
+            }
+            header.elements.back().properties.push_back(property);
+        } else if (keyword == "end_header") {
+            for (PlyElement& element : header.elements) {
+                element.fixedSize = 0;
+                bool fixed = true;
+                for (const PlyProperty& property : element.properties) {
+                    fixed = fixed && !property.isList;
+                    element.fixedSize += plyTypeSize(property.type);
+                }
+                if (!fixed)
+                    element.fixedSize = 0;
+            }
+            return true;
+        }
+    }
+    error = "PLY header without end_header";
+    return false;
+}
+
+// Where the vertex attributes we use live in a vertex record
+struct PlyVertexLayout {
+    int position[3] = { -1, -1, -1 };
+    int color[3] = { -1, -1, -1 };
+    float colorScale = 1.0f; // 1/255 for integer colors
+};
+
+inline PlyVertexLayout plyVertexLayout(const PlyElement& vertex) {
+    PlyVertexLayout layout;
+    const char* positionNames[3] = { "x", "y", "z" };
+    const char* colorNames[3] = { "red", "green", "blue" };
+    for (int p = 0; p < static_cast<int>(vertex.properties.size()); ++p) {
+        const PlyProperty& property = vertex.properties[p];
+        for (int c = 0; c < 3; ++c) {
+            if (property.name == positionNames[c])
+                layout.position[c] = p;
+            if (property.name == colorNames[c] || property.name == std::string("diffuse_") + colorNames[c]) {
+                layout.color[c] = p;
+                if (property.type != PlyType::Float32 && property.type != PlyType::Float64)
+                    layout.colorScale = 1.0f / 255.0f;
+            }
+        }
+    }
+    return layout;
+}
+
+inline bool hasPlyColor(const PlyVertexLayout& layout) {
+    return layout.color[0] >= 0 && layout.color[1] >= 0 && layout.color[2] >= 0;
+}
+
+inline void storePlyVertex(const double* values, const PlyVertexLayout& layout, glm::vec3& position, glm::vec3& color) {
+    for (int c = 0; c < 3; ++c)
+        position[c] = layout.position[c] >= 0 ? static_cast<float>(values[layout.position[c]]) : 0.0f;
+    if (hasPlyColor(layout)) {
+        for (int c = 0; c < 3; ++c)
+            color[c] = static_cast<float>(values[layout.color[c]]) * layout.colorScale;
+    } else {
+        color = glm::vec3(-1.0f);
+    }
+}
+
+inline void appendFan(const std::vector<int64_t>& polygon, std::vector<int64_t>& corners) {
+    for (size_t i = 2; i < polygon.size(); ++i) {
+        corners.push_back(polygon[0]);
+        corners.push_back(polygon[i - 1]);
+        corners.push_back(polygon[i]);
+    }
+}
+
+// Longest list a PLY record may hold, so a corrupt count fails instead of
+// asking for gigabytes
+const size_t maxPlyListCount = size_t(1) << 16;
+
+inline bool plyListCount(double value, size_t& count) {
+    if (!(value >= 0.0) || value > static_cast<double>(maxPlyListCount) || value != std::floor(value))
+        return false;
+    count = static_cast<size_t>(value);
+    return true;
+}
+
+// Buffered reader for binary element data
+class BinaryBlockReader {
+public:
+    BinaryBlockReader(std::istream& stream, size_t blockBytes) : in(stream), blockSize(std::max<size_t>(blockBytes, 4096)) {}
+
+    // Pointer to the next `bytes` bytes, valid until the next call
+    const uint8_t* take(size_t bytes) {
+        if (end - cursor < bytes) {
+            buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(cursor));
+            end -= cursor;
+            cursor = 0;
+            size_t want = std::max(blockSize, bytes);
+            buffer.resize(end + want);
+            in.read(reinterpret_cast<char*>(buffer.data() + end), static_cast<std::streamsize>(want));
+            end += static_cast<size_t>(in.gcount());
+            buffer.resize(end);
+            if (end < bytes)
+                return nullptr;
+        }
+        const uint8_t* data = buffer.data() + cursor;
+        cursor += bytes;
+        return data;
+    }
+
+private:
+    std::istream& in;
+    size_t blockSize;
+    std::vector<uint8_t> buffer;
+    size_t cursor = 0;
+    size_t end = 0;
+};
+
+inline bool skipBinaryPlyRecord(BinaryBlockReader& reader, const PlyElement& element, bool bigEndian) {
+    for (const PlyProperty& property : element.properties) {
+        size_t count = 1;
+        if (property.isList) {
+            const uint8_t* data = reader.take(plyTypeSize(property.countType));
+            if (!data || !plyListCount(readPlyScalar(data, property.countType, bigEndian), count))
+                return false;
+        }
+        if (count > 0 && !reader.take(count * plyTypeSize(property.type)))
+            return false;
+    }
+    return true;
+}
+
+inline bool importBinaryPly(std::istream& in, const PlyHeader& header, JobSystem& jobs, RawGeometry& raw,
+    std::string& error, const ImportOptions& options) {
+    bool bigEndian = header.format == PlyHeader::Format::BinaryBigEndian;
+    BinaryBlockReader reader(in, options.blockBytes);
+    for (const PlyElement& element : header.elements) {
+        if (element.name == "vertex") {
+            if (element.fixedSize == 0) {
+                error = "PLY vertices with list properties are not supported";
+                return false;
+            }
+            PlyVertexLayout layout = plyVertexLayout(element);
+            raw.anyColor = raw.anyColor || hasPlyColor(layout);
+            size_t perBlock = std::max<size_t>(1, options.blockBytes / element.fixedSize);
+            for (uint64_t first = 0; first < element.count; first += perBlock) {
+                size_t count = static_cast<size_t>(std::min<uint64_t>(perBlock, element.count - first));
+                const uint8_t* data = reader.take(count * element.fixedSize);
+                if (!data) {
+                    error = "truncated PLY vertex data";
+                    return false;
+                }
+                size_t base = raw.positions.size();
+                raw.positions.resize(base + count);
+                raw.colors.resize(base + count);
+                // Fixed-size records: every worker can find its vertices directly
+                jobs.parallelFor("import ply", 0, count, 16384, [&](size_t begin, size_t end) {
+                    std::vector<double> values(element.properties.size());
+                    for (size_t v = begin; v < end; ++v) {
+                        const uint8_t* record = data + v * element.fixedSize;
+                        for (size_t p = 0; p < element.properties.size(); ++p) {
+                            values[p] = readPlyScalar(record, element.properties[p].type, bigEndian);
+                            record += plyTypeSize(element.properties[p].type);
+                        }
+                        storePlyVertex(values.data(), layout, raw.positions[base + v], raw.colors[base + v]);
+                    }
+                });
+            }
+        } else if (element.name == "face") {
+            // Variable-length records have to be walked in order
+            std::vector<int64_t> polygon, corners;
+            for (uint64_t f = 0; f < element.count; ++f) {
+                polygon.clear();
+                for (const PlyProperty& property : element.properties) {
+                    bool indices = property.isList && (property.name == "vertex_indices" || property.name == "vertex_index");
+                    size_t count = 1;
+                    if (property.isList) {
+                        const uint8_t* data = reader.take(plyTypeSize(property.countType));
+                        if (!data) {
+                            error = "truncated PLY face data";
+                            return false;
+                        }
+                        if (!plyListCount(readPlyScalar(data, property.countType, bigEndian), count)) {
+                            error = "bad PLY face list length";
+                            return false;
+                        }
+                    }
+                    size_t size = plyTypeSize(property.type);
+                    const uint8_t* data = count > 0 ? reader.take(count * size) : nullptr;
+                    if (count > 0 && !data) {
+                        error = "truncated PLY face data";
+                        return false;
+                    }
+                    for (size_t i = 0; indices && i < count; ++i)
+                        polygon.push_back(static_cast<int64_t>(readPlyScalar(data + i * size, property.type, bigEndian)));
+                }
+                corners.clear();
+                appendFan(polygon, corners);
+                for (int64_t corner : corners) {
+                    if (corner < 0 || static_cast<uint64_t>(corner) >= raw.positions.size()) {
+                        error = "PLY face index out of range";
+                        return false;
+                    }
+                    raw.triangles.push_back(static_cast<uint32_t>(corner));
+                }
+            }
+        } else {
+            for (uint64_t r = 0; r < element.count; ++r) {
+                if (!skipBinaryPlyRecord(reader, element, bigEndian)) {
+                    error = "truncated or corrupt PLY element " + element.name;
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+struct PlyPiece {
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> colors;
+    std::vector<int64_t> corners;
+    uint64_t firstLine = 0; // Global data line number of the piece's first line
+    uint64_t lineCount = 0;
+    bool failed = false;
+    std::string error;
+};
+
+inline uint64_t countLines(const char* begin, const char* end) {
+    uint64_t lines = static_cast<uint64_t>(std::count(begin, end, '\n'));
+    if (begin < end && end[-1] != '\n')
+        ++lines;
+    return lines;
+}
+
+// Bytes from the read position to the end, UINT64_MAX when `in` cannot seek
+inline uint64_t bytesLeft(std::istream& in) {
+    std::streampos here = in.tellg();
+    if (here < 0)
+        return UINT64_MAX;
+    in.seekg(0, std::ios::end);
+    std::streampos end = in.tellg();
+    in.seekg(here);
+    return end > here ? static_cast<uint64_t>(end - here) : 0;
+}
+
+inline bool importAsciiPly(std::istream& in, const PlyHeader& header, JobSystem& jobs, RawGeometry& raw,
+    std::string& error, const ImportOptions& options) {
+    // Data lines are numbered from 0; each element owns a contiguous range
+    uint64_t vertexFirst = 0, vertexCount = 0, faceFirst = 0, faceCount = 0, line = 0;
+    const PlyElement* vertexElement = nullptr;
+    const PlyElement* faceElement = nullptr;
+    // Every record is a line of at least one byte, so the counts cannot add up to more
+    uint64_t available = bytesLeft(in);
+    for (const PlyElement& element : header.elements) {
+        if (element.count > available - line) {
+            error = "bad PLY header: element " + element.name + " has more records than the file holds";
+            return false;
+        }
+        if (element.name == "vertex") {
+            vertexElement = &element;
+            vertexFirst = line;
+            vertexCount = element.count;
+        } else if (element.name == "face") {
+            faceElement = &element;
+            faceFirst = line;
+            faceCount = element.count;
+        }
+        line += element.count;
+    }
+    if (!vertexElement) {
+        error = "PLY file without vertices";
+        return false;
+    }
+    PlyVertexLayout layout = plyVertexLayout(*vertexElement);
+    raw.anyColor = hasPlyColor(layout);
+    int faceListProperty = -1;
+    for (int p = 0; faceElement && p < static_cast<int>(faceElement->properties.size()); ++p) {
+        if (faceElement->properties[p].isList)
+            faceListProperty = p;
+    }
+
+    // "0 " at least per property; the header count alone is not trusted with an allocation
+    uint64_t lineBytes = 2 * std::max<uint64_t>(vertexElement->properties.size(), 1);
+    size_t reserved = static_cast<size_t>(std::min(vertexCount, available / lineBytes));
+    raw.positions.reserve(reserved);
+    raw.colors.reserve(reserved);
+    LineBlockReader reader(in, options.blockBytes);
+    std::vector<char> block;
+    uint64_t nextLine = 0;
+    while (reader.next(block)) {
+        auto ranges = splitLines(block.data(), block.data() + block.size(), jobs.workerCount() * 4);
+        std::vector<PlyPiece> pieces(ranges.size());
+        // Count lines first so every piece knows which element its lines belong to
+        jobs.parallelFor("import ply", 0, ranges.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                pieces[i].lineCount = countLines(ranges[i].first, ranges[i].second);
+        });
+        for (PlyPiece& piece : pieces) {
+            piece.firstLine = nextLine;
+            nextLine += piece.lineCount;
+        }
+        jobs.parallelFor("import ply", 0, ranges.size(), 1, [&](size_t begin, size_t end) {
+            std::vector<double> values(vertexElement->properties.size());
+            std::vector<int64_t> polygon;
+            for (size_t i = begin; i < end; ++i) {
+                PlyPiece& piece = pieces[i];
+                const char* p = ranges[i].first;
+                const char* stop = ranges[i].second;
+                for (uint64_t l = piece.firstLine; p < stop; ++l) {
+                    const char* eol = lineEnd(p, stop);
+                    const char* cursor = p;
+                    if (l >= vertexFirst && l < vertexFirst + vertexCount) {
+                        for (double& value : values) {
+                            float number;
+                            if (!parseFloat(cursor, eol, number)) {
+                                piece.failed = true;
+                                piece.error = "malformed PLY vertex: " + std::string(p, eol);
+                                return;
+                            }
+                            value = number;
+                        }
+                        glm::vec3 position, color;
+                        storePlyVertex(values.data(), layout, position, color);
+                        piece.positions.push_back(position);
+                        piece.colors.push_back(color);
+                    } else if (l >= faceFirst && l < faceFirst + faceCount) {
+                        polygon.clear();
+                        for (int prop = 0; prop < static_cast<int>(faceElement->properties.size()); ++prop) {
+                            int64_t count = 1, value = 0;
+                            if (faceElement->properties[prop].isList && !parseInt(cursor, eol, count)) {
+                                piece.failed = true;
+                                piece.error = "malformed PLY face: " + std::string(p, eol);
+                                return;
+                            }
+                            if (count < 0 || static_cast<uint64_t>(count) > maxPlyListCount) {
+                                piece.failed = true;
+                                piece.error = "bad PLY face list length: " + std::string(p, eol);
+                                return;
+                            }
+                            PlyType type = faceElement->properties[prop].type;
+                            bool isFloat = type == PlyType::Float32 || type == PlyType::Float64;
+                            for (int64_t k = 0; k < count; ++k) {
+                                double number;
+                                if (isFloat ? !parseFloat(cursor, eol, number) : !parseInt(cursor, eol, value)) {
+                                    piece.failed = true;
+                                    piece.error = "malformed PLY face: " + std::string(p, eol);
+                                    return;
+                                }
+                                // Float indices: out of range ones become -1 and fail the index check
+                                if (isFloat)
+                                    value = std::fabs(number) < 9.0e18 ? static_cast<int64_t>(number) : -1;
+                                if (prop == faceListProperty)
+                                    polygon.push_back(value);
+                            }
+                        }
+                        appendFan(polygon, piece.corners);
+                    }
+                    p = eol < stop ? eol + 1 : stop;
+                }
+            }
+        });
+        for (PlyPiece& piece : pieces) {
+            if (piece.failed) {
+                error = piece.error;
+                return false;
+            }
+            raw.positions.insert(raw.positions.end(), piece.positions.begin(), piece.positions.end());
+            raw.colors.insert(raw.colors.end(), piece.colors.begin(), piece.colors.end());
+            for (int64_t corner : piece.corners) {
+                if (corner < 0 || static_cast<uint64_t>(corner) >= vertexCount) {
+                    error = "PLY face index out of range";
+                    return false;
+                }
+                raw.triangles.push_back(static_cast<uint32_t>(corner));
+            }
+        }
+    }
+    if (raw.positions.size() != vertexCount) {
+        error = "truncated PLY vertex data";
+        return false;
+    }
+    return true;
+}
+
+} // namespace importdetail
+
+inline bool importPly(const std::string& path, JobSystem& jobs, MeshData& mesh, std::string& error,
+    const ImportOptions& options = ImportOptions()) {
+    using namespace importdetail;
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    PlyHeader header;
+    if (!readPlyHeader(file, header, error))
+        return false;
+    RawGeometry raw;
+    bool ok = header.format == PlyHeader::Format::Ascii
+        ? importAsciiPly(file, header, jobs, raw, error, options)
+        : importBinaryPly(file, header, jobs, raw, error, options);
+    if (!ok)
+        return false;
+    buildMesh(raw, mesh);
+    return true;
+}
+
+inline bool hasExtension(const std::string& path, const std::string& extension) {
+    if (path.size() < extension.size())
+        return false;
+    std::string tail = path.substr(path.size() - extension.size());
+    std::transform(tail.begin(), tail.end(), tail.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return tail == extension;
+}
+
+// Pick the importer from the file extension (.obj or .ply)
+inline bool importMeshFile(const std::string& path, JobSystem& jobs, MeshData& mesh, std::string& error,
+    const ImportOptions& options = ImportOptions()) {
+    if (hasExtension(path, ".obj"))
+        return importObj(path, jobs, mesh, error, options);
+    if (hasExtension(path, ".ply"))
+        return importPly(path, jobs, mesh, error, options);
+    error = "unsupported file type";
+    return false;
+}
@@ -0,0 +1,314 @@
+#pragma once
+
+// Index and vertex order optimization for triangle lists:
+//   1. Vertex cache: Tipsify (Sander, Nehab, Barczak 2007), linear time, which
+//      also yields the cluster boundaries used by step 2.
+//   2. Overdraw: clusters are split further where the cache efficiency allows
+//      it and sorted so outward-facing clusters draw first, which lets early-z
+//      reject more of what follows.
+//   3. Vertex fetch: vertices are renumbered in order of first use, so the
+//      vertex buffer is read front to back.
+// Each LOD range is optimized on its own. ACMR is the average number of
+// vertex shader runs per triangle (0.5 is ideal for large grids, 3 is worst),
+// ATVR the runs per unique vertex (1 is ideal).
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "mesh.h"
+
+const uint32_t VERTEX_CACHE_SIZE = 16;     // FIFO entries assumed by the simulation and Tipsify
+const float OVERDRAW_CACHE_THRESHOLD = 1.05f; // Allowed ACMR increase for overdraw clusters
+
+struct VertexCacheStats {
+    float acmr = 0.0f;
+    float atvr = 0.0f;
+};
+
+// Simulate a FIFO post-transform cache over a triangle list
+inline VertexCacheStats analyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount,
+    uint32_t cacheSize = VERTEX_CACHE_SIZE) {
+    VertexCacheStats stats;
+    if (indexCount < 3)
+        return stats;
+    std::vector<uint64_t> insertedAt(vertexCount, 0); // FIFO position + 1, 0 = never loaded
+    std::vector<char> used(vertexCount, 0);
+    uint64_t fifoTime = 0;
+    size_t misses = 0;
+    size_t uniqueVertices = 0;
+    for (size_t i = 0; i < indexCount; ++i) {
+        uint32_t v = indices[i];
+        if (insertedAt[v] == 0 || fifoTime - (insertedAt[v] - 1) >= cacheSize) {
+            insertedAt[v] = ++fifoTime;
+            ++misses;
+        }
+        if (!used[v]) {
+            used[v] = 1;
+            ++uniqueVertices;
+        }
+    }
+    stats.acmr = static_cast<float>(misses) / static_cast<float>(indexCount / 3);
+    stats.atvr = static_cast<float>(misses) / static_cast<float>(uniqueVertices);
+    return stats;
+}
+
+namespace optimizedetail {
+
+// Triangles around each vertex (compressed rows)
+struct Adjacency {
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> triangles;
+};
+
+inline Adjacency buildAdjacency(const uint32_t* indices, size_t indexCount, size_t vertexCount) {
+    Adjacency adjacency;
+    adjacency.offsets.assign(vertexCount + 1, 0);
+    for (size_t i = 0; i < indexCount; ++i)
+        ++adjacency.offsets[indices[i] + 1];
+    for (size_t v = 0; v < vertexCount; ++v)
+        adjacency.offsets[v + 1] += adjacency.offsets[v];
+    adjacency.triangles.resize(indexCount);
+    std::vector<uint32_t> cursor(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+    for (size_t i = 0; i < indexCount; ++i)
+        adjacency.triangles[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    return adjacency;
+}
+
+// Tipsify. `clusters` receives the first triangle of every run that started
+// after a cache flush (dead end), which is where overdraw sorting may cut.
+inline void tipsify(const uint32_t* indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize,
+    std::vector<uint32_t>& out, std::vector<uint32_t>& clusters) {
+    size_t triangleCount = indexCount / 3;
+    Adjacency adjacency = buildAdjacency(indices, indexCount, vertexCount);
+    std::vector<uint32_t> liveTriangles(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v)
+        liveTriangles[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+    std::vector<uint64_t> cacheTime(vertexCount, 0);
+    std::vector<char> emitted(triangleCount, 0);
+    std::vector<uint32_t> deadEnds;
+    std::vector<uint32_t> candidates;
+    uint64_t time = cacheSize + 1;
+    size_t cursor = 0;
+    out.clear();
+    out.reserve(indexCount);
+    clusters.clear();
+
+    auto nextRoot = [&]() -> int64_t {
+        while (!deadEnds.empty()) {
+            uint32_t v = deadEnds.back();
+            deadEnds.pop_back();
+            if (liveTriangles[v] > 0)
+                return v;
+        }
+        while (cursor < vertexCount) {
+            if (liveTriangles[cursor] > 0)
+                return static_cast<int64_t>(cursor++);
+            ++cursor;
+        }
+        return -1;
+    };
+
+    int64_t fan = nextRoot();
+    if (fan >= 0)
+        clusters.push_back(0);
+    while (fan >= 0) {
+        candidates.clear();
+        for (uint32_t a = adjacency.offsets[fan]; a < adjacency.offsets[fan + 1]; ++a) {
+            uint32_t t = adjacency.triangles[a];
+            if (emitted[t])
+                continue;
+            emitted[t] = 1;
+            for (int k = 0; k < 3; ++k) {
+                uint32_t v = indices[t * 3 + k];
+                out.push_back(v);
+                deadEnds.push_back(v);
+                candidates.push_back(v);
+                --liveTriangles[v];
+                if (time - cacheTime[v] > cacheSize)
+                    cacheTime[v] = time++;
+            }
+        }
+
+        // Prefer a candidate that is still in the cache after emitting its fan
+        int64_t best = -1;
+        int64_t bestPriority = -1;
+        for (uint32_t v : candidates) {
+            if (liveTriangles[v] == 0)
+                continue;
+            int64_t priority = 0;
+            if (time - cacheTime[v] + 2 * liveTriangles[v] <= cacheSize)
+                priority = static_cast<int64_t>(time - cacheTime[v]);
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                best = v;
+            }
+        }
+        if (best < 0) {
+            best = nextRoot();
+            if (best >= 0)
+                clusters.push_back(static_cast<uint32_t>(out.size() / 3));
+        }
+        fan = best;
+    }
+}
+
+// Split hard clusters where the running ACMR of the cluster so far is already
+// within `threshold` of the whole cluster's ACMR
+inline void softBoundaries(const uint32_t* indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize,
+    float threshold, const std::vector<uint32_t>& hard, std::vector<uint32_t>& soft) {
+    size_t triangleCount = indexCount / 3;
+    std::vector<uint64_t> insertedAt(vertexCount, 0);
+    uint64_t fifoTime = 0;
+    auto missesOf = [&](size_t triangle) {
+        size_t misses = 0;
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = indices[triangle * 3 + k];
+            if (insertedAt[v] == 0 || fifoTime - (insertedAt[v] - 1) >= cacheSize) {
+                insertedAt[v] = ++fifoTime;
+                ++misses;
+            }
+        }
+        return misses;
+    };
+    auto flush = [&]() { fifoTime += cacheSize; };
+
+    soft.clear();
+    for (size_t c = 0; c < hard.size(); ++c) {
+        size_t begin = hard[c];
+        size_t end = c + 1 < hard.size() ? hard[c + 1] : triangleCount;
+        flush();
+        size_t clusterMisses = 0;
+        for (size_t t = begin; t < end; ++t)
+            clusterMisses += missesOf(t);
+        float clusterAcmr = static_cast<float>(clusterMisses) / static_cast<float>(end - begin);
+
+        flush();
+        soft.push_back(static_cast<uint32_t>(begin));
+        size_t start = begin;
+        size_t misses = 0;
+        for (size_t t = begin; t < end; ++t) {
+            misses += missesOf(t);
+            float acmr = static_cast<float>(misses) / static_cast<float>(t + 1 - start);
+            if (t + 1 < end && acmr <= clusterAcmr * threshold) {
+                // Cutting here costs a cache flush, which the next cluster pays for
+                soft.push_back(static_cast<uint32_t>(t + 1));
+                start = t + 1;
+                misses = 0;
+                flush();
+            }
+        }
+    }
+}
+
+// Order clusters so the ones facing away from the mesh center come first
+inline void sortClusters(const uint32_t* indices, size_t indexCount, const std::vector<Vertex>& vertices,
+    const std::vector<uint32_t>& clusters, std::vector<uint32_t>& out) {
+    size_t triangleCount = indexCount / 3;
+    glm::dvec3 meshCenter(0.0);
+    double meshArea = 0.0;
+    std::vector<float> sortKeys(clusters.size());
+    std::vector<glm::dvec3> centers(clusters.size());
+    std::vector<glm::dvec3> normals(clusters.size());
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        size_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+        glm::dvec3 center(0.0), normal(0.0);
+        double area = 0.0;
+        for (size_t t = clusters[c]; t < end; ++t) {
+            glm::dvec3 a(vertices[indices[t * 3]].position);
+            glm::dvec3 b(vertices[indices[t * 3 + 1]].position);
+            glm::dvec3 d(vertices[indices[t * 3 + 2]].position);
+            glm::dvec3 cross = glm::cross(b - a, d - a);
+            double triangleArea = glm::length(cross);
+            center += (a + b + d) * (triangleArea / 3.0);
+            normal += cross;
+            area += triangleArea;
+        }
+        meshCenter += center;
+        meshArea += area;
+        centers[c] = area > 0.0 ? center / area : center;
+        double length = glm::length(normal);
+        normals[c] = length > 0.0 ? normal / length : glm::dvec3(0.0);
+    }
+    if (meshArea > 0.0)
+        meshCenter /= meshArea;
+    for (size_t c = 0; c < clusters.size(); ++c)
+        sortKeys[c] = static_cast<float>(glm::dot(centers[c] - meshCenter, normals[c]));
+
+    std::vector<uint32_t> order(clusters.size());
+    for (uint32_t c = 0; c < order.size(); ++c)
+        order[c] = c;
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+    out.clear();
+    out.reserve(indexCount);
+    for (uint32_t c : order) {
+        size_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+        out.insert(out.end(), indices + clusters[c] * 3, indices + end * 3);
+    }
+}
+
+} // namespace optimizedetail
+
+struct MeshOptimizeReport {
+    VertexCacheStats before;
+    VertexCacheStats after;
+    size_t clusters = 0;
+};
+
+// Reorder triangles for the vertex cache and overdraw, then renumber the
+// vertices for fetch locality. Geometry and LOD ranges are unchanged.
+inline MeshOptimizeReport optimizeMesh(MeshData& mesh, uint32_t cacheSize = VERTEX_CACHE_SIZE,
+    float overdrawThreshold = OVERDRAW_CACHE_THRESHOLD) {
+    MeshOptimizeReport report;
+    size_t vertexCount = mesh.vertices.size();
+    report.before = analyzeVertexCache(mesh.indices.data(), mesh.indices.size(), vertexCount, cacheSize);
+
+    std::vector<MeshLod> lods = mesh.lods;
+    if (lods.empty())
+        lods.push_back({ 0, static_cast<uint32_t>(mesh.indices.size()), 0.0f });
+    std::vector<uint32_t> cacheOrder, hard, soft, sorted;
+    for (const MeshLod& lod : lods) {
+        const uint32_t* indices = mesh.indices.data() + lod.firstIndex;
+        size_t indexCount = lod.indexCount - lod.indexCount % 3;
+        if (indexCount == 0)
+            continue;
+        optimizedetail::tipsify(indices, indexCount, vertexCount, cacheSize, cacheOrder, hard);
+        optimizedetail::softBoundaries(cacheOrder.data(), indexCount, vertexCount, cacheSize, overdrawThreshold,
+            hard, soft);
+        optimizedetail::sortClusters(cacheOrder.data(), indexCount, mesh.vertices, soft, sorted);
+        std::copy(sorted.begin(), sorted.end(), mesh.indices.begin() + lod.firstIndex);
+        report.clusters += soft.size();
+    }
+
+    // Vertex fetch: first use decides the new position, unused vertices go last
+    const uint32_t unassigned = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> remap(vertexCount, unassigned);
+    uint32_t next = 0;
+    for (uint32_t& index : mesh.indices) {
+        if (remap[index] == unassigned)
+            remap[index] = next++;
+        index = remap[index];
+    }
+    for (uint32_t& slot : remap) {
+        if (slot == unassigned)
+            slot = next++;
+    }
+    std::vector<Vertex> reordered(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v)
+        reordered[remap[v]] = mesh.vertices[v];
+    mesh.vertices.swap(reordered);
+
+    report.after = analyzeVertexCache(mesh.indices.data(), mesh.indices.size(), vertexCount, cacheSize);
+    return report;
+}
+
+// 16-bit indices are enough when every vertex can be addressed with them
+inline bool fitsIndex16(size_t vertexCount) {
+    return vertexCount <= 65536;
+}
+
+inline std::vector<uint16_t> narrowIndices(const std::vector<uint32_t>& indices) {
+    return std::vector<uint16_t>(indices.begin(), indices.end());
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+// Meshlets: the index buffer cut into small clusters (at most 64 unique
+// vertices and 124 triangles) that can be culled on their own. Each meshlet
+// keeps a bounding sphere for frustum tests and a normal cone for backface
+// tests; both are in mesh space.
+//
+// Clusters are taken in index order, so meshlets are contiguous index ranges
+// and draw with plain glDrawElements ranges (no mesh shaders needed). Run
+// optimizeMesh() first: its cache order keeps neighbouring triangles together
+// and makes the clusters compact.
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "job_system.h"
+#include "mesh.h"
+
+const uint32_t MESHLET_MAX_VERTICES = 64;
+const uint32_t MESHLET_MAX_TRIANGLES = 124;
+
+// Same layout as the std430 struct in the culling shader
+struct Meshlet {
+    glm::vec4 sphere;    // Center xyz, radius
+    glm::vec4 cone;      // Axis xyz, cutoff: backfacing when dot(normalize(apex - eye), axis) > cutoff
+    glm::vec4 coneApex;  // xyz, w unused
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    uint32_t vertexCount;
+    uint32_t reserved;
+};
+static_assert(sizeof(Meshlet) == 64, "Meshlet must match the GPU layout");
+
+namespace meshletdetail {
+
+inline void computeBounds(const MeshData& mesh, Meshlet& meshlet) {
+    const uint32_t* indices = mesh.indices.data() + meshlet.firstIndex;
+    uint32_t triangleCount = meshlet.indexCount / 3;
+
+    // Sphere around the box center of the cluster
+    glm::vec3 boundsMin = mesh.vertices[indices[0]].position;
+    glm::vec3 boundsMax = boundsMin;
+    for (uint32_t i = 0; i < meshlet.indexCount; ++i) {
+        boundsMin = glm::min(boundsMin, mesh.vertices[indices[i]].position);
+        boundsMax = glm::max(boundsMax, mesh.vertices[indices[i]].position);
+    }
+    glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+    float radius = 0.0f;
+    for (uint32_t i = 0; i < meshlet.indexCount; ++i)
+        radius = std::max(radius, glm::length(mesh.vertices[indices[i]].position - center));
+    meshlet.sphere = glm::vec4(center, radius);
+
+    // Normal cone: axis is the average of the unit triangle normals, the
+    // spread is the largest angle between the axis and any of them
+    glm::vec3 axis(0.0f);
+    std::vector<glm::vec3> normals(triangleCount, glm::vec3(0.0f));
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        glm::vec3 a = mesh.vertices[indices[t * 3]].position;
+        glm::vec3 b = mesh.vertices[indices[t * 3 + 1]].position;
+        glm::vec3 c = mesh.vertices[indices[t * 3 + 2]].position;
+        glm::vec3 normal = glm::cross(b - a, c - a);
+        float length = glm::length(normal);
+        if (length > 0.0f) {
+            normals[t] = normal / length;
+            axis += normals[t];
+        }
+    }
+    float axisLength = glm::length(axis);
+    meshlet.cone = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f); // Cutoff 1: never culled
+    meshlet.coneApex = glm::vec4(center, 0.0f);
+    if (axisLength <= 0.0f)
+        return;
+    axis /= axisLength;
+    float minDot = 1.0f;
+    for (const glm::vec3& normal : normals) {
+        if (normal != glm::vec3(0.0f))
+            minDot = std::min(minDot, glm::dot(normal, axis));
+    }
+    if (minDot <= 0.1f)
+        return; // Cone wider than ~84 degrees, the test would almost never pass
+
+    // Apex on the axis behind every triangle plane, so a camera inside the
+    // backface cone is behind all of them
+    float apexDistance = 0.0f;
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        if (normals[t] == glm::vec3(0.0f))
+            continue;
+        glm::vec3 a = mesh.vertices[indices[t * 3]].position;
+        float dc = glm::dot(center - a, normals[t]);
+        float dn = glm::dot(axis, normals[t]);
+        apexDistance = std::max(apexDistance, dc / dn);
+    }
+    meshlet.cone = glm::vec4(axis, std::sqrt(1.0f - minDot * minDot));
+    meshlet.coneApex = glm::vec4(center - axis * apexDistance, 0.0f);
+}
+
+} // namespace meshletdetail
+
+// Split the index range [firstIndex, firstIndex + indexCount) into meshlets.
+// Cluster boundaries are found in one pass; bounds and cones are computed in
+// parallel on the job system.
+inline std::vector<Meshlet> buildMeshlets(const MeshData& mesh, uint32_t firstIndex, uint32_t indexCount,
+    JobSystem& jobs) {
+    std::vector<Meshlet> meshlets;
+    std::vector<uint32_t> stamp(mesh.vertices.size(), ~0u); // Meshlet that last used the vertex
+    Meshlet current = {};
+    current.firstIndex = firstIndex;
+    uint32_t end = firstIndex + indexCount - indexCount % 3;
+    for (uint32_t i = firstIndex; i < end; i += 3) {
+        uint32_t id = static_cast<uint32_t>(meshlets.size());
+        uint32_t newVertices = 0;
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = mesh.indices[i + k];
+            bool repeated = (k > 0 && mesh.indices[i] == v) || (k > 1 && mesh.indices[i + 1] == v);
+            if (stamp[v] != id && !repeated)
+                ++newVertices;
+        }
+        if (current.indexCount > 0 && (current.vertexCount + newVertices > MESHLET_MAX_VERTICES ||
+            current.indexCount / 3 + 1 > MESHLET_MAX_TRIANGLES)) {
+            meshlets.push_back(current);
+            current = {};
+            current.firstIndex = i;
+            ++id;
+            newVertices = 0;
+            for (int k = 0; k < 3; ++k) {
+                uint32_t v = mesh.indices[i + k];
+                if (stamp[v] != id) {
+                    stamp[v] = id;
+                    ++newVertices;
+                }
+            }
+        } else {
+            for (int k = 0; k < 3; ++k)
+                stamp[mesh.indices[i + k]] = id;
+        }
+        current.vertexCount += newVertices;
+        current.indexCount += 3;
+    }
+    if (current.indexCount > 0)
+        meshlets.push_back(current);
+
+    jobs.parallelFor("meshlet bounds", 0, meshlets.size(), 256, [&](size_t begin, size_t chunkEnd) {
+        for (size_t m = begin; m < chunkEnd; ++m)
+            meshletdetail::computeBounds(mesh, meshlets[m]);
+    });
+    return meshlets;
+}
@@ -0,0 +1,247 @@
+#pragma once
+
+// GPU meshlet culling. A compute pass tests every (instance, meshlet) pair
+// against the frustum and the meshlet's normal cone, and appends one
+// DrawElementsIndirect command per survivor to a compacted buffer. The draw
+// consumes that buffer with glMultiDrawElementsIndirectCount when
+// ARB_indirect_parameters is present; otherwise the buffer is cleared every
+// frame and the unused tail draws nothing.
+//
+// The instance matrix reaches the vertex shader as attributes 3-6 with a
+// divisor of 1, selected by each command's baseInstance, so the glTF program
+// (transform * aInstance * aPos) draws meshlets as well.
+//
+// Needs OpenGL 4.3 (compute shaders, SSBOs, multi-draw indirect); check
+// isSupported() first. Cone culling assumes closed meshes wound CCW.
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "gpu_mesh.h"
+#include "meshlet.h"
+#include "scene.h"
+
+const char* const MESHLET_CULL_SHADER_SOURCE = R"glsl(
+    #version 430 core
+    layout (local_size_x = 64) in;
+
+    struct Meshlet {
+        vec4 sphere;
+        vec4 cone;
+        vec4 coneApex;
+        uvec4 range; // firstIndex, indexCount, vertexCount, reserved
+    };
+    struct DrawCommand {
+        uint count;
+        uint instanceCount;
+        uint firstIndex;
+        int baseVertex;
+        uint baseInstance;
+    };
+
+    layout (std430, binding = 0) readonly buffer Meshlets { Meshlet meshlets[]; };
+    layout (std430, binding = 1) readonly buffer Instances { mat4 models[]; };
+    layout (std430, binding = 2) writeonly buffer Draws { DrawCommand draws[]; };
+    layout (std430, binding = 3) buffer DrawCount { uint drawCount; };
+
+    uniform uint meshletCount;
+    uniform uint instanceCount;
+    uniform vec4 frustumPlanes[6];
+    uniform vec3 cameraPosition;
+
+    void main() {
+        uint id = gl_GlobalInvocationID.x;
+        if (id >= meshletCount * instanceCount)
+            return;
+        uint instance = id / meshletCount;
+        Meshlet meshlet = meshlets[id % meshletCount];
+        mat4 model = models[instance];
+
+        vec3 scale = vec3(length(model[0].xyz), length(model[1].xyz), length(model[2].xyz));
+        float maxScale = max(scale.x, max(scale.y, scale.z));
+        vec3 center = (model * vec4(meshlet.sphere.xyz, 1.0)).xyz;
+        float radius = meshlet.sphere.w * maxScale;
+        for (int i = 0; i < 6; ++i) {
+            if (dot(frustumPlanes[i].xyz, center) + frustumPlanes[i].w < -radius)
+                return;
+        }
+
+        // The cone angle only survives uniform scaling
+        float minScale = min(scale.x, min(scale.y, scale.z));
+        if (maxScale - minScale <= 0.001 * maxScale) {
+            vec3 apex = (model * vec4(meshlet.coneApex.xyz, 1.0)).xyz;
+            vec3 axis = normalize(mat3(model) * meshlet.cone.xyz);
+            if (dot(normalize(apex - cameraPosition), axis) > meshlet.cone.w)
+                return;
+        }
+
+        uint slot = atomicAdd(drawCount, 1u);
+        draws[slot] = DrawCommand(meshlet.range.y, 1u, meshlet.range.x, 0, instance);
+    }
+)glsl";
+
+struct DrawElementsIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
+static_assert(sizeof(DrawElementsIndirectCommand) == 20, "Layout fixed by glMultiDrawElementsIndirect");
+
+class MeshletCuller {
+public:
+    static bool isSupported() {
+        return GLEW_VERSION_4_3 != 0;
+    }
+
+    // Upload the meshlets of `mesh` and set up a vertex array that reads its
+    // buffers plus the per-instance matrices
+    bool init(const GpuMesh& mesh, const std::vector<Meshlet>& meshletList) {
+        program = compileComputeProgram(MESHLET_CULL_SHADER_SOURCE);
+        if (!program)
+            return false;
+        meshletCountLoc = glGetUniformLocation(program, "meshletCount");
+        instanceCountLoc = glGetUniformLocation(program, "instanceCount");
+        frustumPlanesLoc = glGetUniformLocation(program, "frustumPlanes");
+        cameraPositionLoc = glGetUniformLocation(program, "cameraPosition");
+        hasDrawCount = GLEW_VERSION_4_6 || GLEW_ARB_indirect_parameters;
+
+        meshletCount = static_cast<uint32_t>(meshletList.size());
+        meshletBuffer = createBuffer(meshletList.size() * sizeof(Meshlet), meshletList.data());
+        countBuffer = createBuffer(sizeof(GLuint), nullptr, GL_DYNAMIC_STORAGE_BIT);
+        glGenBuffers(1, &drawBuffer);
+        // Re-specified every cull(); it has to exist before the vertex array can reference it
+        glGenBuffers(1, &instanceBuffer);
+        glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        vertexArray = meshVertexArray(mesh).buffer(1, instanceBuffer, 0, sizeof(glm::mat4), 1)
+            .matrixAttribute(3, 1).create();
+        indexType = mesh.indexType;
+        return true;
+    }
+
+    // Cull the meshlets of every instance; `models` map mesh space to world
+    void cull(const std::vector<glm::mat4>& models, const Frustum& frustum, const glm::vec3& cameraPosition) {
+        instanceCount = static_cast<uint32_t>(models.size());
+        size_t maxDraws = static_cast<size_t>(instanceCount) * meshletCount;
+        if (maxDraws == 0)
+            return;
+        glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+        glBufferData(GL_ARRAY_BUFFER, models.size() * sizeof(glm::mat4), models.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        if (maxDraws > drawCapacity) {
+            drawCapacity = maxDraws;
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, drawBuffer);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, drawCapacity * sizeof(DrawElementsIndirectCommand), nullptr,
+                GL_DYNAMIC_DRAW);
+        }
+        if (!hasDrawCount) {
+            // Without a GPU draw count every slot is drawn, so clear the stale ones
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, drawBuffer);
+            glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+        }
+        const GLuint zero = 0;
+        writeBuffer(countBuffer, 0, sizeof(zero), &zero);
+
+        glUseProgram(program);
+        glUniform1ui(meshletCountLoc, meshletCount);
+        glUniform1ui(instanceCountLoc, instanceCount);
+        glUniform4fv(frustumPlanesLoc, 6, glm::value_ptr(frustum.planes[0]));
+        glUniform3fv(cameraPositionLoc, 1, glm::value_ptr(cameraPosition));
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, meshletBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, instanceBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, drawBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, countBuffer);
+        glDispatchCompute(static_cast<GLuint>((maxDraws + 63) / 64), 1, 1);
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+    }
+
+    // Draw the surviving meshlets with `program` already bound
+    void draw() const {
+        size_t maxDraws = static_cast<size_t>(instanceCount) * meshletCount;
+        if (maxDraws == 0)
+            return;
+        glBindVertexArray(vertexArray);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, drawBuffer);
+        if (hasDrawCount) {
+            glBindBuffer(GL_PARAMETER_BUFFER_ARB, countBuffer);
+            glMultiDrawElementsIndirectCountARB(GL_TRIANGLES, indexType, nullptr, 0,
+                static_cast<GLsizei>(maxDraws), 0);
+            glBindBuffer(GL_PARAMETER_BUFFER_ARB, 0);
+        } else {
+            glMultiDrawElementsIndirect(GL_TRIANGLES, indexType, nullptr, static_cast<GLsizei>(maxDraws), 0);
+        }
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        glBindVertexArray(0);
+    }
+
+    // Meshlets drawn by the last cull(); waits for the GPU, use for statistics only
+    uint32_t readDrawCount() const {
+        GLuint count = 0;
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, countBuffer);
+        glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(count), &count);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        return count;
+    }
+
+    uint32_t meshletsPerInstance() const { return meshletCount; }
+
+    void destroy() {
+        glDeleteProgram(program);
+        glDeleteVertexArrays(1, &vertexArray);
+        GLuint buffers[] = { meshletBuffer, instanceBuffer, drawBuffer, countBuffer };
+        glDeleteBuffers(4, buffers);
+        *this = MeshletCuller();
+    }
+
+private:
+    static GLuint compileComputeProgram(const char* source) {
+        GLuint shader = glCreateShader(GL_COMPUTE_SHADER);
+        glShaderSource(shader, 1, &source, NULL);
+        glCompileShader(shader);
+        int success;
+        char infoLog[512];
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+        if (!success) {
+            glGetShaderInfoLog(shader, 512, NULL, infoLog);
+            std::cerr << "ERROR::SHADER::COMPUTE::COMPILATION_FAILED\n" << infoLog << std::endl;
+            glDeleteShader(shader);
+            return 0;
+        }
+        GLuint computeProgram = glCreateProgram();
+        glAttachShader(computeProgram, shader);
+        glLinkProgram(computeProgram);
+        glDeleteShader(shader);
+        glGetProgramiv(computeProgram, GL_LINK_STATUS, &success);
+        if (!success) {
+            glGetProgramInfoLog(computeProgram, 512, NULL, infoLog);
+            std::cerr << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+            glDeleteProgram(computeProgram);
+            return 0;
+        }
+        return computeProgram;
+    }
+
+    GLuint program = 0;
+    GLint meshletCountLoc = -1;
+    GLint instanceCountLoc = -1;
+    GLint frustumPlanesLoc = -1;
+    GLint cameraPositionLoc = -1;
+    bool hasDrawCount = false;
+    GLuint meshletBuffer = 0;
+    GLuint instanceBuffer = 0;
+    GLuint drawBuffer = 0;
+    GLuint countBuffer = 0;
+    GLuint vertexArray = 0;
+    GLenum indexType = GL_UNSIGNED_INT;
+    uint32_t meshletCount = 0;
+    uint32_t instanceCount = 0;
+    size_t drawCapacity = 0;
+};
@@ -4,6 +4,7 @@
 #include <glm\gtc\matrix_transform.hpp>
 #include <glm\gtc\type_ptr.hpp>
 #include <iostream>
+#include "gl_resources.h"
 
 // 窗口尺寸
 const int WIDTH = 800, HEIGHT = 600;
@@ -113,27 +114,17 @@ int main() {
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
 
-    // 创建 VAO、VBO、EBO
-    GLuint VAO, VBO, EBO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
-
-    glBindVertexArray(VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-    // 顶点属性指针
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
-    glEnableVertexAttribArray(1);
-
-    glBindVertexArray(0);
+    // 创建 VBO、EBO（不可变存储，无需绑定）
+    GLuint VBO = createBuffer(sizeof(vertices), vertices);
+    GLuint EBO = createBuffer(sizeof(indices), indices);
+
+    // 顶点格式：位置和颜色都来自绑定点 0
+    GLuint VAO = VertexArrayBuilder()
+        .buffer(0, VBO, 0, 6 * sizeof(GLfloat))
+        .attribute(0, 0, 3, GL_FLOAT, false, 0)
+        .attribute(1, 0, 3, GL_FLOAT, false, 3 * sizeof(GLfloat))
+        .indices(EBO)
+        .create();
 
     // 渲染循环
     while (!glfwWindowShouldClose(window)) {
@@ -0,0 +1,207 @@
+#pragma once
+
+// Pyramids without vertex or index buffers. The vertex shader builds the 18
+// corners of the assignment pyramid (6 triangles) from gl_VertexID and reads
+// the instance's parameters (position, rotation, base size, height, corner
+// colors) with gl_InstanceID. Parameters live in an SSBO on OpenGL 4.3; a
+// 3.3 context reads the same 48-byte records from an unsigned integer
+// texture buffer instead. The vertex array stays empty, core profile only
+// requires one to be bound.
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "gl_resources.h"
+#include "scene.h"
+
+// One pyramid, same layout as the std430 struct in the shader
+struct ProceduralPyramid {
+    glm::vec4 positionAngle; // World position xyz, rotation about z in w
+    float baseSize;
+    float height;
+    uint32_t colors[5];      // packUnorm4x8: the four base corners, then the apex
+    uint32_t reserved;
+};
+static_assert(sizeof(ProceduralPyramid) == 48, "ProceduralPyramid must match the GPU layout");
+
+// Parameters of an instance drawn with the assignment pyramid's colors
+inline ProceduralPyramid makeProceduralPyramid(const PyramidInstance& instance) {
+    static const uint32_t colors[5] = {
+        glm::packUnorm4x8(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f)), // Bottom left - Red
+        glm::packUnorm4x8(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f)), // Bottom right - Green
+        glm::packUnorm4x8(glm::vec4(0.0f, 0.0f, 1.0f, 1.0f)), // Top right - Blue
+        glm::packUnorm4x8(glm::vec4(1.0f, 1.0f, 0.0f, 1.0f)), // Top left - Yellow
+        glm::packUnorm4x8(glm::vec4(1.0f, 0.5f, 0.2f, 1.0f))  // Peak - Orange
+    };
+    ProceduralPyramid pyramid;
+    pyramid.positionAngle = glm::vec4(instance.position, instance.rotationAngle);
+    pyramid.baseSize = 1.0f;
+    pyramid.height = instance.scaleZ;
+    for (int i = 0; i < 5; ++i)
+        pyramid.colors[i] = colors[i];
+    pyramid.reserved = 0;
+    return pyramid;
+}
+
+// Shared body; the header picks where the 48-byte records come from
+const char* const PROCEDURAL_PYRAMID_SHADER_BODY = R"glsl(
+    out vec3 vertexColor;
+    layout (std140) uniform Frame {
+        mat4 view;
+        mat4 projection;
+        mat4 viewProjection;
+        mat4 inverseProjection;
+        vec4 viewportTime;
+    };
+
+    // Corner of each of the 18 vertices, in the order of the indexed pyramid
+    const int CORNERS[18] = int[18](0, 1, 2,  2, 3, 0,  0, 1, 4,  1, 2, 4,  2, 3, 4,  3, 0, 4);
+
+    void main() {
+        int corner = CORNERS[gl_VertexID];
+        vec4 positionAngle;
+        vec2 size;
+        uint color;
+        loadPyramid(gl_InstanceID, corner, positionAngle, size, color);
+
+        vec3 local = corner == 4 ? vec3(0.0, 0.0, size.y)
+            : vec3((corner == 1 || corner == 2) ? 0.5 : -0.5, corner >= 2 ? 0.5 : -0.5, 0.0) * size.x;
+        float c = cos(positionAngle.w);
+        float s = sin(positionAngle.w);
+        vec3 world = positionAngle.xyz + vec3(c * local.x - s * local.y, s * local.x + c * local.y, local.z);
+        gl_Position = viewProjection * vec4(world, 1.0);
+        vertexColor = unpackUnorm4x8(color).rgb;
+    }
+)glsl";
+
+const char* const PROCEDURAL_PYRAMID_SSBO_HEADER = R"glsl(
+    #version 430 core
+    struct Pyramid {
+        vec4 positionAngle;
+        float baseSize;
+        float height;
+        uint colors[5];
+        uint reserved;
+    };
+    layout (std430, binding = 0) readonly buffer Pyramids { Pyramid pyramids[]; };
+
+    void loadPyramid(int instance, int corner, out vec4 positionAngle, out vec2 size, out uint color) {
+        positionAngle = pyramids[instance].positionAngle;
+        size = vec2(pyramids[instance].baseSize, pyramids[instance].height);
+        color = pyramids[instance].colors[corner];
+    }
+)glsl";
+
+// Three RGBA32UI texels per pyramid; unpackUnorm4x8 is emulated (GLSL 4.00+)
+const char* const PROCEDURAL_PYRAMID_TBO_HEADER = R"glsl(
+    #version 330 core
+    uniform usamplerBuffer pyramids;
+
+    vec4 unpackUnorm4x8(uint value) {
+        return vec4(uvec4(value, value >> 8u, value >> 16u, value >> 24u) & 255u) / 255.0;
+    }
+
+    void loadPyramid(int instance, int corner, out vec4 positionAngle, out vec2 size, out uint color) {
+        uvec4 texel0 = texelFetch(pyramids, instance * 3);
+        uvec4 texel1 = texelFetch(pyramids, instance * 3 + 1);
+        uvec4 texel2 = texelFetch(pyramids, instance * 3 + 2);
+        positionAngle = uintBitsToFloat(texel0);
+        size = uintBitsToFloat(texel1.xy);
+        uint colors[5] = uint[5](texel1.z, texel1.w, texel2.x, texel2.y, texel2.z);
+        color = colors[corner];
+    }
+)glsl";
+
+class ProceduralPyramidRenderer {
+public:
+    static bool hasStorageBuffers() {
+        return GLEW_VERSION_4_3 != 0;
+    }
+
+    // Vertex shader for this context; link it with any fragment shader that
+    // takes `in vec3 vertexColor`
+    static std::string vertexShaderSource() {
+        return std::string(hasStorageBuffers() ? PROCEDURAL_PYRAMID_SSBO_HEADER : PROCEDURAL_PYRAMID_TBO_HEADER) +
+            PROCEDURAL_PYRAMID_SHADER_BODY;
+    }
+
+    // Draws with `linkedProgram`, built from vertexShaderSource(); the caller keeps ownership
+    void init(GLuint linkedProgram) {
+        useStorageBuffer = hasStorageBuffers();
+        program = linkedProgram;
+        glGenVertexArrays(1, &emptyVertexArray);
+        if (useStorageBuffer) {
+            GLint alignment = 256;
+            glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+            buffer.init(static_cast<size_t>(alignment));
+        } else {
+            // The texture sees the whole buffer, so there is one slice at offset 0
+            buffer.init(1, 1);
+            glGenTextures(1, &texture);
+            glUseProgram(program);
+            glUniform1i(glGetUniformLocation(program, "pyramids"), 0);
+            glUseProgram(0);
+        }
+    }
+
+    // Replace the parameters drawn next; chunks are written back to back
+    // into the next slice of the stream buffer
+    void upload(const std::vector<std::vector<ProceduralPyramid>>& chunks) {
+        count = 0;
+        for (const auto& chunk : chunks)
+            count += static_cast<GLsizei>(chunk.size());
+        buffer.begin(static_cast<size_t>(count) * sizeof(ProceduralPyramid));
+        if (!useStorageBuffer && textureBuffer != buffer.id()) {
+            // The stream buffer grew into a new object
+            textureBuffer = buffer.id();
+            glBindTexture(GL_TEXTURE_BUFFER, texture);
+            glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32UI, textureBuffer);
+            glBindTexture(GL_TEXTURE_BUFFER, 0);
+        }
+        size_t offset = 0;
+        for (const auto& chunk : chunks) {
+            size_t chunkBytes = chunk.size() * sizeof(ProceduralPyramid);
+            buffer.write(offset, chunk.data(), chunkBytes);
+            offset += chunkBytes;
+        }
+    }
+
+    // The camera comes from the Frame uniform block (uniform_blocks.h)
+    void draw() const {
+        if (count == 0)
+            return;
+        glUseProgram(program);
+        if (useStorageBuffer) {
+            glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, buffer.id(), static_cast<GLintptr>(buffer.offset()),
+                static_cast<GLsizeiptr>(buffer.size()));
+        } else {
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_BUFFER, texture);
+        }
+        glBindVertexArray(emptyVertexArray);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 18, count);
+        glBindVertexArray(0);
+    }
+
+    GLsizei drawnCount() const { return count; }
+
+    void destroy() {
+        glDeleteVertexArrays(1, &emptyVertexArray);
+        buffer.destroy();
+        if (texture)
+            glDeleteTextures(1, &texture);
+        *this = ProceduralPyramidRenderer();
+    }
+
+private:
+    bool useStorageBuffer = false;
+    GLuint program = 0;
+    GLuint emptyVertexArray = 0;
+    StreamBuffer buffer;
+    GLuint texture = 0;
+    GLuint textureBuffer = 0; // Buffer object the texture currently reads
+    GLsizei count = 0;
+};
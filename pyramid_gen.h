@@ -0,0 +1,134 @@
+#pragma once
+
+// Procedural pyramids: an N-sided pyramid (regular base on z = 0, apex at
+// z = 1; four sides give the assignment pyramid) and the Sierpinski pyramid
+// built from it. Each recursion level replaces a pyramid by N + 1 copies at
+// half size, one at every base corner and one at the apex, so depth d has
+// (N + 1)^d leaf pyramids.
+//
+// A leaf's position follows directly from its index written in base N + 1
+// (one digit per level), so any range of leaves can be generated on its own
+// and in any order. Output is deterministic.
+
+#include <glm/glm.hpp>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "job_system.h"
+#include "mesh.h"
+
+struct PyramidGenParams {
+    uint32_t sides = 4;  // Base corners, at least 3
+    uint32_t depth = 0;  // Sierpinski levels, 0 = a single pyramid
+};
+
+const uint32_t PYRAMID_GEN_MAX_SIDES = 64;
+
+inline uint32_t pyramidVertexCount(uint32_t sides) { return sides + 1; }
+inline uint32_t pyramidIndexCount(uint32_t sides) { return (sides + sides - 2) * 3; } // Sides + base fan
+
+inline uint64_t sierpinskiLeafCount(const PyramidGenParams& params) {
+    uint64_t count = 1;
+    for (uint32_t level = 0; level < params.depth; ++level)
+        count *= params.sides + 1;
+    return count;
+}
+
+// False if the parameters are out of range or the mesh would not fit 32-bit
+// indices and a GLsizei index count
+inline bool validPyramidParams(const PyramidGenParams& params) {
+    if (params.sides < 3 || params.sides > PYRAMID_GEN_MAX_SIDES || params.depth > 32)
+        return false;
+    double leaves = std::pow(double(params.sides + 1), double(params.depth));
+    return leaves * pyramidIndexCount(params.sides) <= 2147483647.0;
+}
+
+namespace pyramidgendetail {
+
+// Base corners counter-clockwise from (-0.5, -0.5), then the apex
+inline glm::vec3 corner(uint32_t sides, uint32_t k) {
+    if (k == sides)
+        return glm::vec3(0.0f, 0.0f, 1.0f);
+    if (sides == 4) {
+        // Exact values of the assignment pyramid
+        static const glm::vec3 square[4] = { { -0.5f, -0.5f, 0.0f }, { 0.5f, -0.5f, 0.0f },
+            { 0.5f, 0.5f, 0.0f }, { -0.5f, 0.5f, 0.0f } };
+        return square[k];
+    }
+    const double pi = 3.14159265358979323846;
+    double angle = -0.75 * pi + 2.0 * pi * k / sides;
+    double radius = std::sqrt(0.5);
+    return glm::vec3(static_cast<float>(radius * std::cos(angle)), static_cast<float>(radius * std::sin(angle)), 0.0f);
+}
+
+// The assignment colors for the first four corners and the apex
+inline glm::vec3 cornerColor(uint32_t sides, uint32_t k) {
+    static const glm::vec3 palette[6] = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f },
+        { 1.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, 1.0f }, { 1.0f, 0.0f, 1.0f } };
+    return k == sides ? glm::vec3(1.0f, 0.5f, 0.2f) : palette[k % 6];
+}
+
+} // namespace pyramidgendetail
+
+// Write leaves [firstLeaf, firstLeaf + leafCount) to `vertices` and `indices`
+// (sized for that many leaves). Indices are absolute in the whole mesh.
+inline void generateSierpinskiLeaves(const PyramidGenParams& params, uint64_t firstLeaf, uint64_t leafCount,
+    Vertex* vertices, uint32_t* indices) {
+    const uint32_t sides = params.sides;
+    const uint32_t leafVertices = pyramidVertexCount(sides);
+    glm::vec3 corners[PYRAMID_GEN_MAX_SIDES + 1];
+    for (uint32_t k = 0; k <= sides; ++k)
+        corners[k] = pyramidgendetail::corner(sides, k);
+    const float leafScale = std::ldexp(1.0f, -static_cast<int>(params.depth));
+
+    for (uint64_t n = 0; n < leafCount; ++n) {
+        // Digits from the deepest level up: each level halves the previous offsets
+        uint64_t leaf = firstLeaf + n;
+        glm::vec3 offset(0.0f);
+        for (uint32_t level = 0; level < params.depth; ++level) {
+            offset = offset * 0.5f + corners[leaf % (sides + 1)] * 0.5f;
+            leaf /= sides + 1;
+        }
+        Vertex* v = vertices + n * leafVertices;
+        for (uint32_t k = 0; k <= sides; ++k)
+            v[k] = { corners[k] * leafScale + offset, pyramidgendetail::cornerColor(sides, k) };
+
+        // Outward-facing winding: sides (k, k+1, apex), base fan seen from below
+        uint32_t base = static_cast<uint32_t>((firstLeaf + n) * leafVertices);
+        uint32_t* i = indices + n * pyramidIndexCount(sides);
+        for (uint32_t k = 0; k < sides; ++k) {
+            *i++ = base + k;
+            *i++ = base + (k + 1) % sides;
+            *i++ = base + sides;
+        }
+        for (uint32_t k = 1; k + 1 < sides; ++k) {
+            *i++ = base;
+            *i++ = base + k + 1;
+            *i++ = base + k;
+        }
+    }
+}
+
+// Every level stays inside the base pyramid and touches its corners
+inline void sierpinskiBounds(const PyramidGenParams& params, glm::vec3& boundsMin, glm::vec3& boundsMax) {
+    boundsMin = boundsMax = pyramidgendetail::corner(params.sides, params.sides);
+    for (uint32_t k = 0; k < params.sides; ++k) {
+        boundsMin = glm::min(boundsMin, pyramidgendetail::corner(params.sides, k));
+        boundsMax = glm::max(boundsMax, pyramidgendetail::corner(params.sides, k));
+    }
+}
+
+// The whole mesh in memory, generated in parallel
+inline MeshData generateSierpinski(const PyramidGenParams& params, JobSystem& jobs) {
+    MeshData mesh;
+    uint64_t leaves = sierpinskiLeafCount(params);
+    mesh.vertices.resize(leaves * pyramidVertexCount(params.sides));
+    mesh.indices.resize(leaves * pyramidIndexCount(params.sides));
+    jobs.parallelFor("sierpinski", 0, leaves, 16384, [&](size_t begin, size_t end) {
+        generateSierpinskiLeaves(params, begin, end - begin,
+            mesh.vertices.data() + begin * pyramidVertexCount(params.sides),
+            mesh.indices.data() + begin * pyramidIndexCount(params.sides));
+    });
+    sierpinskiBounds(params, mesh.boundsMin, mesh.boundsMax);
+    return mesh;
+}
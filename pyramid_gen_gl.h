@@ -0,0 +1,96 @@
+#pragma once
+
+// Streams a generated Sierpinski pyramid to the GPU. The buffers are
+// allocated at their final size up front; worker jobs generate chunks of
+// leaves while the calling thread uploads finished chunks in order with
+// writeBuffer(). Only a few chunks are in flight at once, so CPU memory
+// stays small however large the mesh is.
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "gpu_mesh.h"
+#include "job_system.h"
+#include "mesh_optimize.h"
+#include "pyramid_gen.h"
+
+const uint64_t PYRAMID_STREAM_CHUNK_LEAVES = 16384;
+
+namespace pyramidstreamdetail {
+
+struct Chunk {
+    Job job;
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<uint16_t> indices16; // Replaces `indices` when the mesh fits 16-bit indices
+};
+
+} // namespace pyramidstreamdetail
+
+inline GpuMesh uploadSierpinski(const PyramidGenParams& params, JobSystem& jobs) {
+    using pyramidstreamdetail::Chunk;
+    const uint64_t leaves = sierpinskiLeafCount(params);
+    const uint32_t leafVertices = pyramidVertexCount(params.sides);
+    const uint32_t leafIndices = pyramidIndexCount(params.sides);
+    const bool index16 = fitsIndex16(leaves * leafVertices);
+    const size_t indexSize = index16 ? sizeof(uint16_t) : sizeof(uint32_t);
+
+    // Storage the CPU fills chunk by chunk
+    GpuMesh mesh;
+    mesh.vertexBuffer = createBuffer(leaves * leafVertices * sizeof(Vertex), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    mesh.indexBuffer = createBuffer(leaves * leafIndices * indexSize, nullptr, GL_DYNAMIC_STORAGE_BIT);
+    mesh.vertexFormat = VertexFormat::PositionColorF32;
+    mesh.vertexStride = sizeof(Vertex);
+    mesh.vertexArray = meshVertexArray(mesh).create();
+
+    const uint64_t chunkCount = (leaves + PYRAMID_STREAM_CHUNK_LEAVES - 1) / PYRAMID_STREAM_CHUNK_LEAVES;
+    const uint64_t window = std::max<uint64_t>(2, jobs.workerCount() * 2);
+    std::vector<std::unique_ptr<Chunk>> chunks(chunkCount);
+    auto start = [&](uint64_t c) {
+        uint64_t first = c * PYRAMID_STREAM_CHUNK_LEAVES;
+        uint64_t count = std::min(PYRAMID_STREAM_CHUNK_LEAVES, leaves - first);
+        chunks[c] = std::make_unique<Chunk>();
+        Chunk* chunk = chunks[c].get();
+        chunk->job.name = "sierpinski chunk";
+        chunk->job.function = [&params, chunk, first, count, leafVertices, leafIndices, index16] {
+            chunk->vertices.resize(count * leafVertices);
+            chunk->indices.resize(count * leafIndices);
+            generateSierpinskiLeaves(params, first, count, chunk->vertices.data(), chunk->indices.data());
+            if (index16) {
+                chunk->indices16 = narrowIndices(chunk->indices);
+                chunk->indices = std::vector<uint32_t>();
+            }
+        };
+        jobs.submit(chunk->job);
+    };
+    for (uint64_t c = 0; c < std::min(window, chunkCount); ++c)
+        start(c);
+
+    // Upload in order; the wait runs queued chunks if nothing else is ready
+    for (uint64_t c = 0; c < chunkCount; ++c) {
+        Chunk& chunk = *chunks[c];
+        jobs.wait(chunk.job);
+        uint64_t first = c * PYRAMID_STREAM_CHUNK_LEAVES;
+        writeBuffer(mesh.vertexBuffer, first * leafVertices * sizeof(Vertex), chunk.vertices.size() * sizeof(Vertex),
+            chunk.vertices.data());
+        if (index16)
+            writeBuffer(mesh.indexBuffer, first * leafIndices * indexSize, chunk.indices16.size() * indexSize,
+                chunk.indices16.data());
+        else
+            writeBuffer(mesh.indexBuffer, first * leafIndices * indexSize, chunk.indices.size() * indexSize,
+                chunk.indices.data());
+        chunks[c].reset();
+        if (c + window < chunkCount)
+            start(c + window);
+    }
+
+    mesh.indexType = index16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    mesh.indexCount = static_cast<GLsizei>(leaves * leafIndices);
+    mesh.lods.push_back({ 0, static_cast<uint32_t>(leaves * leafIndices), 0.0f });
+    glm::vec3 boundsMin, boundsMax;
+    sierpinskiBounds(params, boundsMin, boundsMax);
+    boundingSphere(boundsMin, boundsMax, mesh.boundsCenter, mesh.boundsRadius);
+    return mesh;
+}
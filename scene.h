@@ -0,0 +1,127 @@
+#pragma once
+
+// Scene description shared by the frame jobs: pyramid instances, their
+// per-frame transforms and view-frustum culling.
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "command_list.h"
+#include "uniform_blocks.h"
+
+// One pyramid in the scene. Instance 0 is the pyramid driven by the keyboard;
+// the others form the optional stress grid and spin in place.
+struct PyramidInstance {
+    glm::vec3 position = glm::vec3(0.0f);
+    float rotationAngle = 0.0f;
+    float spinSpeed = 0.0f; // Radians per second, 0 for the keyboard pyramid
+    float scaleZ = 1.0f;
+    glm::mat4 model = glm::mat4(1.0f);
+    glm::mat4 transform = glm::mat4(1.0f); // projection * view * model
+    bool visible = true;
+};
+
+// One draw issued for every visible instance, with the program state it needs
+struct DrawItem {
+    uint32_t program = 0;
+    int32_t transformLocation = -1;
+    glm::vec4 baseColor = glm::vec4(1.0f);
+    uint32_t materialBuffer = 0;    // Material block slot, 0 if the program has none
+    uint32_t materialOffset = 0;
+    uint32_t vertexArray = 0;
+    PrimitiveType primitive = PrimitiveType::Triangles;
+    bool indexed = true;
+    IndexType indexType = IndexType::UInt32;
+    uint32_t count = 0;
+    uint32_t first = 0; // First index, or first vertex when not indexed
+    uint32_t instanceCount = 1;
+    glm::mat4 meshTransform = glm::mat4(1.0f); // Applied first, e.g. position dequantization
+};
+
+// Record one draw as its own packet
+inline void recordDraw(CommandList& list, const DrawItem& draw, const glm::mat4& transform, float depth01) {
+    list.beginPacket(makeSortKey(0, draw.program, draw.vertexArray, depth01));
+    list.bindProgram(draw.program);
+    list.bindVertexArray(draw.vertexArray);
+    list.setUniform(draw.transformLocation, transform * draw.meshTransform);
+    if (draw.materialBuffer != 0)
+        list.bindUniformBuffer(MATERIAL_BLOCK_BINDING, draw.materialBuffer, draw.materialOffset,
+            sizeof(MaterialUniforms));
+    if (draw.indexed)
+        list.drawIndexed(draw.primitive, draw.indexType, draw.count, draw.first, draw.instanceCount);
+    else
+        list.drawArrays(draw.primitive, draw.first, draw.count, draw.instanceCount);
+}
+
+// Six clip planes (left, right, bottom, top, near, far) as ax + by + cz + d >= 0
+struct Frustum {
+    glm::vec4 planes[6];
+};
+
+inline Frustum extractFrustum(const glm::mat4& viewProjection) {
+    // Gribb/Hartmann: combine the rows of the clip matrix
+    glm::vec4 row0(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+    glm::vec4 row1(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+    glm::vec4 row2(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+    glm::vec4 row3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+    Frustum frustum;
+    frustum.planes[0] = row3 + row0;
+    frustum.planes[1] = row3 - row0;
+    frustum.planes[2] = row3 + row1;
+    frustum.planes[3] = row3 - row1;
+    frustum.planes[4] = row3 + row2;
+    frustum.planes[5] = row3 - row2;
+    for (glm::vec4& plane : frustum.planes)
+        plane /= glm::length(glm::vec3(plane));
+    return frustum;
+}
+
+inline bool sphereInFrustum(const Frustum& frustum, const glm::vec3& center, float radius) {
+    for (const glm::vec4& plane : frustum.planes) {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+            return false;
+    }
+    return true;
+}
+
+// Model matrix in the same order the keyboard controls have always used
+inline glm::mat4 pyramidModelMatrix(const PyramidInstance& instance) {
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model, instance.position);
+    model = glm::rotate(model, instance.rotationAngle, glm::vec3(0.0f, 0.0f, 1.0f));
+    model = glm::scale(model, glm::vec3(1.0f, 1.0f, instance.scaleZ));
+    return model;
+}
+
+// World-space bounding sphere of an instance whose model matrix is up to date,
+// given the mesh's bounding sphere in model space
+inline void instanceWorldBounds(const PyramidInstance& instance, const glm::vec3& localCenter, float localRadius,
+    glm::vec3& center, float& radius) {
+    center = glm::vec3(instance.model * glm::vec4(localCenter, 1.0f));
+    float maxScale = std::max({ glm::length(glm::vec3(instance.model[0])),
+        glm::length(glm::vec3(instance.model[1])), glm::length(glm::vec3(instance.model[2])) });
+    radius = localRadius * maxScale;
+}
+
+// Instance 0 at the origin for the keyboard, plus a gridSize x gridSize field of
+// spinning pyramids around it (the cell under the origin is left out)
+inline std::vector<PyramidInstance> makePyramidScene(int gridSize, float spacing = 1.5f) {
+    std::vector<PyramidInstance> instances(1);
+    float half = (gridSize - 1) * 0.5f;
+    for (int y = 0; y < gridSize; ++y) {
+        for (int x = 0; x < gridSize; ++x) {
+            PyramidInstance instance;
+            instance.position = glm::vec3((x - half) * spacing, (y - half) * spacing, 0.0f);
+            if (glm::length(instance.position) < 0.5f * spacing)
+                continue;
+            instance.rotationAngle = 0.37f * (x * gridSize + y);
+            instance.spinSpeed = 0.5f + 0.25f * ((x + y) % 5);
+            instances.push_back(instance);
+        }
+    }
+    return instances;
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+// Templates of every scene shader, specialized per draw by ShaderCache
+// (shader_cache_gl.h) with the features in shader_permutation.h. Only the
+// procedural vertex stage lives elsewhere (procedural_pyramid_gl.h).
+
+// Coordinate system: the Z-axis points upwards. Colors are vec4 for every
+// layout: RGB float colors get w = 1, RGBA8 ones come normalized, and
+// instanced draws without colors read white.
+const char* const SCENE_VERTEX_SHADER_TEMPLATE = R"glsl(
+    #version 330 core
+    #ifdef QUANTIZED
+    layout (location = 0) in vec4 aPos; // w is stored as 1.0
+    #else
+    layout (location = 0) in vec3 aPos;
+    #endif
+    #ifndef DEPTH_ONLY
+    layout (location = 1) in vec4 aColor;
+    out vec3 vertexColor;
+    #ifdef INSTANCED
+    layout (std140) uniform Material {
+        vec4 baseColor;
+    };
+    #endif
+    #endif
+    #ifdef INSTANCED
+    layout (location = 3) in mat4 aInstance;
+    #endif
+    uniform mat4 transform;
+    void main() {
+    #ifdef QUANTIZED
+        vec4 position = aPos;
+    #else
+        vec4 position = vec4(aPos, 1.0);
+    #endif
+    #ifdef INSTANCED
+        gl_Position = transform * aInstance * position;
+    #else
+        gl_Position = transform * position;
+    #endif
+    #ifndef DEPTH_ONLY
+    #ifdef INSTANCED
+        vertexColor = aColor.rgb * baseColor.rgb;
+    #else
+        vertexColor = aColor.rgb;
+    #endif
+    #endif
+    }
+)glsl";
+
+// Unlit: the vertex color. LIGHTING adds the clustered point lights
+// (clustered_lights_gl.h): the view space position is rebuilt from the depth
+// and the face normal from its screen derivatives, so vertex formats without
+// normals light the same as the rest. SHADOWS adds the sun and its cascades
+// (shadow_cascades_gl.h). DEPTH_ONLY casters need no fragment work.
+const char* const SCENE_FRAGMENT_SHADER_TEMPLATE = R"glsl(
+    #ifdef LIGHTING
+    #version 430 core
+    #else
+    #version 330 core
+    #endif
+    #ifdef DEPTH_ONLY
+    void main() {
+    }
+    #else
+    in vec3 vertexColor;
+    out vec4 FragColor;
+
+    #ifdef LIGHTING
+    struct PointLight {
+        vec4 positionRadius;
+        vec4 color;
+    };
+    layout (std430, binding = 4) readonly buffer Lights { PointLight lights[]; };
+    layout (std430, binding = 5) readonly buffer Clusters { uvec2 clusterRanges[]; };
+    layout (std430, binding = 6) readonly buffer LightIndices { uint lightIndices[]; };
+
+    // uniform_blocks.h
+    layout (std140) uniform Frame {
+        mat4 view;
+        mat4 projection;
+        mat4 viewProjection;
+        mat4 inverseProjection;
+        vec4 viewportTime;        // Viewport size in pixels, time
+    };
+    layout (std140) uniform Lighting {
+        uvec4 clusterCount;
+        vec4 sliceScaleBias;      // Slice = log(depth) * x + y
+        vec4 ambient;
+        vec4 sunDirection;        // View space, towards the sun
+        vec4 sunColor;
+        vec4 cascadeSplits;       // View depth where each cascade ends
+        mat4 viewToShadow[3];     // SHADOW_CASCADES
+    };
+
+    #ifdef SHADOWS
+    const int CASCADES = 3;
+    uniform sampler2DArrayShadow shadowMap;
+
+    float sunVisibility(vec3 position, vec3 normal) {
+        float depth = -position.z;
+        if (depth > cascadeSplits[CASCADES - 1])
+            return 1.0;
+        int cascade = 0;
+        while (cascade < CASCADES - 1 && depth > cascadeSplits[cascade])
+            ++cascade;
+        // Small push along the normal against acne on surfaces facing away from the sun
+        vec4 coord = viewToShadow[cascade] * vec4(position + normal * 0.01 * float(cascade + 1), 1.0);
+        return texture(shadowMap, vec4(coord.xy, float(cascade), coord.z));
+    }
+    #endif
+    #endif
+
+    void main() {
+    #ifdef LIGHTING
+        vec2 screen = gl_FragCoord.xy / viewportTime.xy;
+        vec4 viewPosition = inverseProjection * vec4(vec3(screen, gl_FragCoord.z) * 2.0 - 1.0, 1.0);
+        vec3 position = viewPosition.xyz / viewPosition.w;
+        vec3 normal = normalize(cross(dFdx(position), dFdy(position)));
+
+        uvec2 tile = min(uvec2(screen * vec2(clusterCount.xy)), clusterCount.xy - 1u);
+        uint slice = uint(clamp(log(-position.z) * sliceScaleBias.x + sliceScaleBias.y, 0.0,
+            float(clusterCount.z - 1u)));
+        uvec2 range = clusterRanges[(slice * clusterCount.y + tile.y) * clusterCount.x + tile.x];
+
+        vec3 light = ambient.rgb;
+    #ifdef SHADOWS
+        light += sunColor.rgb * max(dot(normal, sunDirection.xyz), 0.0) * sunVisibility(position, normal);
+    #endif
+        for (uint i = 0u; i < range.y; ++i) {
+            PointLight pointLight = lights[lightIndices[range.x + i]];
+            vec3 toLight = pointLight.positionRadius.xyz - position;
+            float distance = length(toLight);
+            // Smooth falloff that reaches zero at the radius
+            float falloff = clamp(1.0 - pow(distance / pointLight.positionRadius.w, 4.0), 0.0, 1.0);
+            falloff = falloff * falloff / (distance * distance + 1.0);
+            light += pointLight.color.rgb * max(dot(normal, toLight / distance), 0.0) * falloff;
+        }
+        FragColor = vec4(vertexColor * light, 1.0);
+    #else
+        FragColor = vec4(vertexColor, 1.0f);
+    #endif
+    }
+    #endif
+)glsl";
@@ -0,0 +1,165 @@
+#pragma once
+
+// Lazily compiled shader permutations. get(features) is the only entry
+// point: the first request for a key preprocesses both stage templates
+// (shader_permutation.h) and looks the resulting texts up by hash, so a
+// stage is compiled once however many keys share it, and a program is linked
+// once per distinct pair of stages. Keys nothing asks for are never built.
+// The cache owns every shader and program it returns, and points their
+// uniform blocks at the binding points of uniform_blocks.h.
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "shader_permutation.h"
+#include "uniform_blocks_gl.h"
+
+// Compile one stage, printing any errors; `stageName` goes into the message
+inline GLuint compileShader(GLenum stage, const char* source, const char* stageName) {
+    GLuint shader = glCreateShader(stage);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+    int success;
+    char infoLog[512];
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        std::cerr << "ERROR::SHADER::" << stageName << "::COMPILATION_FAILED\n" << infoLog << std::endl;
+    }
+    return shader;
+}
+
+// Link compiled stages into a program, printing any errors; the stages stay alive
+inline GLuint linkProgram(GLuint vertexShader, GLuint fragmentShader) {
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    int success;
+    char infoLog[512];
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cerr << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+    }
+    glDetachShader(program, vertexShader);
+    glDetachShader(program, fragmentShader);
+    return program;
+}
+
+// Compile and link a vertex/fragment shader pair, printing any errors
+inline GLuint compileProgram(const char* vertexSource, const char* fragmentSource) {
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource, "VERTEX");
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource, "FRAGMENT");
+    GLuint program = linkProgram(vertexShader, fragmentShader);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    return program;
+}
+
+class ShaderCache {
+public:
+    struct Stats {
+        size_t keys = 0;     // Distinct keys requested
+        size_t programs = 0; // Programs linked
+        size_t shaders = 0;  // Stages compiled
+    };
+
+    void init(std::string vertexTemplate, std::string fragmentTemplate) {
+        vertexTemplates.clear();
+        vertexTemplates.push_back({ 0, std::move(vertexTemplate) });
+        this->fragmentTemplate = std::move(fragmentTemplate);
+    }
+
+    // Keys with `feature` build their vertex stage from `source` instead
+    void setVertexTemplate(uint32_t feature, std::string source) {
+        vertexTemplates.push_back({ feature, std::move(source) });
+    }
+
+    // The program specialized for `features`, built on first use
+    GLuint get(uint32_t features) {
+        auto found = keyPrograms.find(features);
+        if (found != keyPrograms.end())
+            return found->second;
+
+        GLuint vertexShader = stage(GL_VERTEX_SHADER, vertexTemplateFor(features), features);
+        GLuint fragmentShader = stage(GL_FRAGMENT_SHADER, fragmentTemplate, features);
+        uint64_t pairHash = stageHashes[vertexShader] * 31 + stageHashes[fragmentShader];
+        GLuint& program = programs[pairHash];
+        if (program == 0) {
+            program = linkProgram(vertexShader, fragmentShader);
+            if (!bindUniformBlocks(program))
+                std::cerr << "Uniform block layout mismatch in " << shaderFeatureString(features) << std::endl;
+            programFeatures.push_back({ program, 0 });
+        }
+        for (auto& entry : programFeatures) {
+            if (entry.first == program)
+                entry.second |= features;
+        }
+        keyPrograms[features] = program;
+        return program;
+    }
+
+    // Every program built so far for a key with `feature`, each once; for
+    // the few uniforms that cannot live in a block
+    std::vector<GLuint> programsWith(uint32_t feature) const {
+        std::vector<GLuint> result;
+        for (const auto& entry : programFeatures) {
+            if (entry.second & feature)
+                result.push_back(entry.first);
+        }
+        return result;
+    }
+
+    Stats stats() const {
+        Stats result;
+        result.keys = keyPrograms.size();
+        result.programs = programs.size();
+        result.shaders = shaders.size();
+        return result;
+    }
+
+    void destroy() {
+        for (const auto& entry : programs)
+            glDeleteProgram(entry.second);
+        for (const auto& entry : shaders)
+            glDeleteShader(entry.second);
+        *this = ShaderCache();
+    }
+
+private:
+    const std::string& vertexTemplateFor(uint32_t features) const {
+        // Later overrides win; the first entry is the default
+        for (size_t i = vertexTemplates.size(); i-- > 1;) {
+            if (features & vertexTemplates[i].first)
+                return vertexTemplates[i].second;
+        }
+        return vertexTemplates.front().second;
+    }
+
+    GLuint stage(GLenum type, const std::string& source, uint32_t features) {
+        std::string text, error;
+        if (!preprocessShader(source, features, text, error))
+            std::cerr << "ERROR::SHADER::PREPROCESS " << shaderFeatureString(features) << ": " << error << std::endl;
+        // The stage type is part of the key: identical text may not be shared across stages
+        uint64_t hash = hashShaderSource(text) ^ type;
+        GLuint& shader = shaders[hash];
+        if (shader == 0) {
+            shader = compileShader(type, text.c_str(), type == GL_VERTEX_SHADER ? "VERTEX" : "FRAGMENT");
+            stageHashes[shader] = hash;
+        }
+        return shader;
+    }
+
+    std::vector<std::pair<uint32_t, std::string>> vertexTemplates;
+    std::string fragmentTemplate;
+    std::unordered_map<uint32_t, GLuint> keyPrograms;   // Permutation key -> program
+    std::unordered_map<uint64_t, GLuint> shaders;       // Preprocessed text hash -> stage
+    std::unordered_map<GLuint, uint64_t> stageHashes;
+    std::unordered_map<uint64_t, GLuint> programs;      // Hash of both stages -> program
+    std::vector<std::pair<GLuint, uint32_t>> programFeatures; // Program, features of the keys using it
+};
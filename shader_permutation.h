@@ -0,0 +1,146 @@
+#pragma once
+
+// Shader permutations, CPU side. Stage templates mark optional code with
+// #ifdef/#ifndef/#else/#endif on feature names; a permutation key is the set
+// of features one draw needs. The conditionals are resolved here rather than
+// by the driver, so each stage's text keeps only what the key switches on and
+// permutations that differ in features a stage ignores (instancing for the
+// fragment stage, say) produce the same text and the same hash.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Feature bits of a permutation key
+const uint32_t SHADER_INSTANCED = 1u << 0;  // Instance matrix from attributes 3-6 and a base color
+const uint32_t SHADER_QUANTIZED = 1u << 1;  // Packed vertices: 4-component positions
+const uint32_t SHADER_LIGHTING = 1u << 2;   // Clustered point lights (OpenGL 4.3)
+const uint32_t SHADER_SHADOWS = 1u << 3;    // Sun with cascaded shadow maps, needs LIGHTING
+const uint32_t SHADER_DEPTH_ONLY = 1u << 4; // Shadow casters: no color work at all
+const uint32_t SHADER_PROCEDURAL = 1u << 5; // Vertices generated from instance parameters
+
+// Names usable in the templates' conditionals, in bit order
+inline const char* shaderFeatureName(uint32_t bit) {
+    static const char* const names[] = { "INSTANCED", "QUANTIZED", "LIGHTING", "SHADOWS", "DEPTH_ONLY",
+        "PROCEDURAL" };
+    for (uint32_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+        if (bit == 1u << i)
+            return names[i];
+    }
+    return nullptr;
+}
+
+// "INSTANCED|LIGHTING", for logs
+inline std::string shaderFeatureString(uint32_t features) {
+    std::string text;
+    for (uint32_t bit = 1; bit != 0 && bit <= features; bit <<= 1) {
+        const char* name = (features & bit) ? shaderFeatureName(bit) : nullptr;
+        if (name)
+            text += (text.empty() ? "" : "|") + std::string(name);
+    }
+    return text.empty() ? "NONE" : text;
+}
+
+namespace shaderdetail {
+
+inline bool featureDefined(const std::string& name, uint32_t features) {
+    for (uint32_t bit = 1; bit != 0; bit <<= 1) {
+        const char* feature = shaderFeatureName(bit);
+        if (!feature)
+            break;
+        if (name == feature)
+            return (features & bit) != 0;
+    }
+    return false;
+}
+
+// Directive and argument of a preprocessor line, false for anything else
+inline bool parseDirective(const std::string& line, std::string& directive, std::string& argument) {
+    size_t i = line.find_first_not_of(" \t");
+    if (i == std::string::npos || line[i] != '#')
+        return false;
+    size_t nameBegin = line.find_first_not_of(" \t", i + 1);
+    if (nameBegin == std::string::npos)
+        return false;
+    size_t nameEnd = line.find_first_of(" \t", nameBegin);
+    directive = line.substr(nameBegin, nameEnd == std::string::npos ? std::string::npos : nameEnd - nameBegin);
+    argument.clear();
+    if (nameEnd != std::string::npos) {
+        size_t argumentBegin = line.find_first_not_of(" \t", nameEnd);
+        if (argumentBegin != std::string::npos) {
+            size_t argumentEnd = line.find_last_not_of(" \t\r");
+            argument = line.substr(argumentBegin, argumentEnd + 1 - argumentBegin);
+        }
+    }
+    return true;
+}
+
+} // namespace shaderdetail
+
+// Resolve the feature conditionals of `source` for `features`; every
+// #ifdef/#ifndef tests a feature name, unknown names are undefined. Other
+// directives (#version, #define) are kept as they are. Returns false and
+// sets `error` on an unbalanced #else/#endif.
+inline bool preprocessShader(const std::string& source, uint32_t features, std::string& out, std::string& error) {
+    out.clear();
+    out.reserve(source.size());
+    // Per open conditional: is its current branch taken, was the code around it kept
+    struct Branch {
+        bool active;
+        bool parentActive;
+    };
+    std::vector<Branch> stack;
+    bool active = true;
+    size_t lineBegin = 0;
+    while (lineBegin < source.size()) {
+        size_t lineEnd = source.find('\n', lineBegin);
+        if (lineEnd == std::string::npos)
+            lineEnd = source.size();
+        std::string line = source.substr(lineBegin, lineEnd - lineBegin);
+        lineBegin = lineEnd + 1;
+
+        std::string directive, argument;
+        if (shaderdetail::parseDirective(line, directive, argument)) {
+            if (directive == "ifdef" || directive == "ifndef") {
+                bool defined = shaderdetail::featureDefined(argument, features);
+                stack.push_back({ directive == "ifdef" ? defined : !defined, active });
+                active = active && stack.back().active;
+                continue;
+            }
+            if (directive == "else" || directive == "endif") {
+                if (stack.empty()) {
+                    error = "#" + directive + " without #ifdef";
+                    return false;
+                }
+                if (directive == "else") {
+                    stack.back().active = !stack.back().active;
+                    active = stack.back().parentActive && stack.back().active;
+                } else {
+                    active = stack.back().parentActive;
+                    stack.pop_back();
+                }
+                continue;
+            }
+        }
+        if (active) {
+            out += line;
+            out += '\n';
+        }
+    }
+    if (!stack.empty()) {
+        error = "missing #endif";
+        return false;
+    }
+    return true;
+}
+
+// FNV-1a over the preprocessed text; 64 bits make collisions between a
+// handful of shader stages a non-issue
+inline uint64_t hashShaderSource(const std::string& text) {
+    uint64_t hash = 1469598103934665603ull;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+// Cascaded shadow maps for one directional light, CPU side. The camera
+// frustum up to SHADOW_DISTANCE is split into cascades (a blend of uniform
+// and logarithmic splits); each cascade is an orthographic box around the
+// bounding sphere of its slice, so its size does not change when the camera
+// turns. The box is snapped to whole shadow map texels in light space, so
+// it only moves in texel steps and edges do not shimmer.
+//
+// Casters are split in two layers. Static ones (not spinning) are rendered
+// into a cached map that is only redrawn when the cascade moves by a texel
+// or a static caster inside it moves; dynamic ones are drawn over a copy of
+// the cache every frame.
+
+#include <glm/glm.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include "scene.h"
+
+const int SHADOW_CASCADES = 3;
+const int SHADOW_MAP_SIZE = 1024;
+const float SHADOW_DISTANCE = 30.0f;     // Receivers further away are unshadowed
+const float SHADOW_SPLIT_LAMBDA = 0.7f;  // 0 = uniform splits, 1 = logarithmic
+const float SHADOW_CASTER_MARGIN = 20.0f; // Extra depth towards the light for casters outside the view
+
+struct ShadowCascade {
+    glm::mat4 viewProjection = glm::mat4(1.0f);
+    Frustum frustum;
+    float splitDepth = 0.0f;   // View depth where the next cascade takes over
+    glm::vec4 snappedCenter = glm::vec4(0.0f); // Light space center and radius, for change detection
+    bool staticDirty = true;   // The cached static casters must be drawn again
+};
+
+class ShadowCascades {
+public:
+    // Recompute the boxes for this frame's camera; cascades whose box moved
+    // get their static cache invalidated
+    void update(const glm::mat4& view, float fovY, float aspect, float nearZ, const glm::vec3& lightDirection) {
+        glm::vec3 up = std::abs(lightDirection.z) > 0.99f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(0.0f, 0.0f, 1.0f);
+        glm::mat4 lightView = glm::lookAt(glm::vec3(0.0f), lightDirection, up);
+        glm::mat4 inverseView = glm::inverse(view);
+        float tanY = std::tan(fovY * 0.5f);
+        float tanX = tanY * aspect;
+        float sliceNear = nearZ;
+        for (int c = 0; c < SHADOW_CASCADES; ++c) {
+            float fraction = static_cast<float>(c + 1) / SHADOW_CASCADES;
+            float logSplit = nearZ * std::pow(SHADOW_DISTANCE / nearZ, fraction);
+            float uniformSplit = nearZ + (SHADOW_DISTANCE - nearZ) * fraction;
+            float sliceFar = SHADOW_SPLIT_LAMBDA * logSplit + (1.0f - SHADOW_SPLIT_LAMBDA) * uniformSplit;
+
+            // Bounding sphere of the slice: its center on the view axis only
+            // depends on the projection, so the radius is stable
+            glm::vec3 center(0.0f, 0.0f, -(sliceNear + sliceFar) * 0.5f);
+            float radius = 0.0f;
+            for (float depth : { sliceNear, sliceFar }) {
+                glm::vec3 corner(tanX * depth, tanY * depth, -depth);
+                radius = std::max(radius, glm::length(corner - center));
+            }
+            radius = std::ceil(radius * 16.0f) / 16.0f;
+
+            // Snap the light space center to whole texels
+            glm::vec3 lightCenter = glm::vec3(lightView * inverseView * glm::vec4(center, 1.0f));
+            float texel = 2.0f * radius / SHADOW_MAP_SIZE;
+            lightCenter = glm::floor(lightCenter / texel) * texel;
+
+            ShadowCascade& cascade = cascades[c];
+            glm::vec4 snapped(lightCenter, radius);
+            if (snapped != cascade.snappedCenter) {
+                cascade.snappedCenter = snapped;
+                cascade.staticDirty = true;
+            }
+            // Light space looks down -z; casters between the light and the box are kept
+            glm::mat4 projection = glm::ortho(lightCenter.x - radius, lightCenter.x + radius,
+                lightCenter.y - radius, lightCenter.y + radius,
+                -(lightCenter.z + radius + SHADOW_CASTER_MARGIN), -(lightCenter.z - radius));
+            cascade.viewProjection = projection * lightView;
+            cascade.frustum = extractFrustum(cascade.viewProjection);
+            cascade.splitDepth = sliceFar;
+            sliceNear = sliceFar;
+        }
+    }
+
+    // A static caster moved from one sphere to another: the cascades that saw
+    // either position must redraw their cache. Safe to call from jobs.
+    void invalidate(const glm::vec3& oldCenter, float oldRadius, const glm::vec3& newCenter, float newRadius) {
+        uint32_t mask = 0;
+        for (int c = 0; c < SHADOW_CASCADES; ++c) {
+            if (sphereInFrustum(cascades[c].frustum, oldCenter, oldRadius) ||
+                sphereInFrustum(cascades[c].frustum, newCenter, newRadius))
+                mask |= 1u << c;
+        }
+        if (mask)
+            movedMask.fetch_or(mask, std::memory_order_relaxed);
+    }
+
+    // After every invalidate() of the frame: does cascade c redraw its static layer?
+    bool staticDirty(int c) const {
+        return cascades[c].staticDirty || (movedMask.load(std::memory_order_relaxed) & (1u << c)) != 0;
+    }
+
+    // Call once the static layers have been drawn
+    void staticDrawn() {
+        for (ShadowCascade& cascade : cascades)
+            cascade.staticDirty = false;
+        movedMask.store(0, std::memory_order_relaxed);
+    }
+
+    const ShadowCascade& cascade(int c) const { return cascades[c]; }
+
+private:
+    ShadowCascade cascades[SHADOW_CASCADES];
+    std::atomic<uint32_t> movedMask{ 0 };
+};
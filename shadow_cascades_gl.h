@@ -0,0 +1,142 @@
+#pragma once
+
+// GL side of the cascaded shadow maps: two depth texture arrays with one
+// layer per cascade. `cache` holds the static casters and is only redrawn
+// when a cascade is invalidated; `shadowMap` is what the SHADOWS permutation
+// of the scene fragment shader samples, a copy of the cache with the dynamic
+// casters drawn on top. When nothing in the scene is dynamic, the copy is
+// skipped while the cache is unchanged. Casters draw with the DEPTH_ONLY
+// permutation.
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <iostream>
+#include <string>
+#include "shadow_cascades.h"
+#include "uniform_blocks.h"
+
+const int SHADOW_MAP_TEXTURE_UNIT = 1;
+
+class ShadowMapsGL {
+public:
+    void init() {
+        cache = createDepthArray(false);
+        shadowMap = createDepthArray(true);
+        glGenFramebuffers(1, &drawFramebuffer);
+        glGenFramebuffers(1, &readFramebuffer);
+    }
+
+    // Target the static cache of cascade c and clear it
+    void beginStatic(int c) {
+        bindLayer(GL_FRAMEBUFFER, drawFramebuffer, cache, c);
+        glClear(GL_DEPTH_BUFFER_BIT);
+    }
+
+    // Target the sampled map of cascade c, starting from its static cache
+    void beginDynamic(int c) {
+        bindLayer(GL_READ_FRAMEBUFFER, readFramebuffer, cache, c);
+        bindLayer(GL_DRAW_FRAMEBUFFER, drawFramebuffer, shadowMap, c);
+        glBlitFramebuffer(0, 0, SHADOW_MAP_SIZE, SHADOW_MAP_SIZE, 0, 0, SHADOW_MAP_SIZE, SHADOW_MAP_SIZE,
+            GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, drawFramebuffer);
+    }
+
+    // Caster state for the passes in between; end() restores the scene's
+    // framebuffer and viewport
+    void begin() {
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &sceneFramebuffer);
+        glGetIntegerv(GL_VIEWPORT, sceneViewport);
+        glViewport(0, 0, SHADOW_MAP_SIZE, SHADOW_MAP_SIZE);
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        glEnable(GL_POLYGON_OFFSET_FILL);
+        glPolygonOffset(2.0f, 4.0f);
+    }
+
+    void end() const {
+        glDisable(GL_POLYGON_OFFSET_FILL);
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(sceneFramebuffer));
+        glViewport(sceneViewport[0], sceneViewport[1], sceneViewport[2], sceneViewport[3]);
+    }
+
+    // This frame's sun and cascades in the Lighting block
+    static void writeUniforms(LightingUniforms& uniforms, const ShadowCascades& cascades, const glm::mat4& view,
+        const glm::vec3& lightDirection, const glm::vec3& lightColor) {
+        static_assert(sizeof(uniforms.viewToShadow) / sizeof(uniforms.viewToShadow[0]) == SHADOW_CASCADES,
+            "The Lighting block needs one matrix per cascade");
+        // Clip space [-1, 1] to texture space [0, 1]
+        const glm::mat4 bias(0.5f, 0.0f, 0.0f, 0.0f, 0.0f, 0.5f, 0.0f, 0.0f, 0.0f, 0.0f, 0.5f, 0.0f,
+            0.5f, 0.5f, 0.5f, 1.0f);
+        glm::mat4 inverseView = glm::inverse(view);
+        uniforms.cascadeSplits = glm::vec4(0.0f);
+        for (int c = 0; c < SHADOW_CASCADES; ++c) {
+            uniforms.viewToShadow[c] = bias * cascades.cascade(c).viewProjection * inverseView;
+            uniforms.cascadeSplits[c] = cascades.cascade(c).splitDepth;
+        }
+        uniforms.sunDirection = glm::vec4(glm::normalize(glm::vec3(view * glm::vec4(-lightDirection, 0.0f))), 0.0f);
+        uniforms.sunColor = glm::vec4(lightColor, 0.0f);
+    }
+
+    // Samplers cannot live in a block: once per program built with SHADER_SHADOWS
+    static void setSampler(GLuint program) {
+        glUseProgram(program);
+        glUniform1i(glGetUniformLocation(program, "shadowMap"), SHADOW_MAP_TEXTURE_UNIT);
+        glUseProgram(0);
+    }
+
+    void bindForSampling() const {
+        glActiveTexture(GL_TEXTURE0 + SHADOW_MAP_TEXTURE_UNIT);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, shadowMap);
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    void destroy() {
+        glDeleteTextures(1, &cache);
+        glDeleteTextures(1, &shadowMap);
+        glDeleteFramebuffers(1, &drawFramebuffer);
+        glDeleteFramebuffers(1, &readFramebuffer);
+        *this = ShadowMapsGL();
+    }
+
+private:
+    static GLuint createDepthArray(bool sampled) {
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24, SHADOW_MAP_SIZE, SHADOW_MAP_SIZE,
+            SHADOW_CASCADES, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, nullptr);
+        if (sampled) {
+            // Hardware 2x2 PCF; outside the map counts as lit
+            const float border[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+            glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, border);
+        } else {
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        }
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        return texture;
+    }
+
+    static void bindLayer(GLenum target, GLuint framebuffer, GLuint texture, int layer) {
+        glBindFramebuffer(target, framebuffer);
+        glFramebufferTextureLayer(target, GL_DEPTH_ATTACHMENT, texture, 0, layer);
+        if (target != GL_READ_FRAMEBUFFER)
+            glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+        if (glCheckFramebufferStatus(target) != GL_FRAMEBUFFER_COMPLETE)
+            std::cerr << "ERROR::FRAMEBUFFER::SHADOW_INCOMPLETE layer " << layer << std::endl;
+    }
+
+    GLuint cache = 0;
+    GLuint shadowMap = 0;
+    GLuint drawFramebuffer = 0;
+    GLuint readFramebuffer = 0;
+    GLint sceneFramebuffer = 0;
+    GLint sceneViewport[4] = {};
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+// std140 uniform blocks shared by the scene shaders. Per-frame data (camera,
+// viewport, time) and the lighting setup are written once per frame into one
+// buffer each and bound to fixed binding points, so every program reads the
+// same copy instead of getting its own uniforms. Materials live in one
+// buffer, one aligned slot each, and draws bind their slot.
+//
+// The structs mirror the GLSL declarations in scene_shaders.h and
+// procedural_pyramid_gl.h member for member. Only vec4/uvec4/mat4 members
+// are used, so the std140 offsets are the plain C++ ones; the static_asserts
+// pin them and bindUniformBlocks() (uniform_blocks_gl.h) compares them with
+// what the driver reports for every linked program.
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+
+const uint32_t FRAME_BLOCK_BINDING = 0;
+const uint32_t LIGHTING_BLOCK_BINDING = 1;
+const uint32_t MATERIAL_BLOCK_BINDING = 2;
+
+// layout (std140) uniform Frame
+struct FrameUniforms {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 viewProjection;
+    glm::mat4 inverseProjection;
+    glm::vec4 viewportTime; // Viewport width and height in pixels, seconds of simulation, unused
+};
+static_assert(offsetof(FrameUniforms, view) == 0, "FrameUniforms must match the std140 layout");
+static_assert(offsetof(FrameUniforms, projection) == 64, "FrameUniforms must match the std140 layout");
+static_assert(offsetof(FrameUniforms, viewProjection) == 128, "FrameUniforms must match the std140 layout");
+static_assert(offsetof(FrameUniforms, inverseProjection) == 192, "FrameUniforms must match the std140 layout");
+static_assert(offsetof(FrameUniforms, viewportTime) == 256, "FrameUniforms must match the std140 layout");
+static_assert(sizeof(FrameUniforms) == 272, "FrameUniforms must match the std140 layout");
+
+// layout (std140) uniform Lighting; only read by LIGHTING permutations, the
+// sun members only by SHADOWS ones
+struct LightingUniforms {
+    glm::uvec4 clusterCount;   // Tiles x, tiles y, slices, unused
+    glm::vec4 sliceScaleBias;  // Slice = log(depth) * x + y
+    glm::vec4 ambient;         // rgb
+    glm::vec4 sunDirection;    // View space, towards the sun
+    glm::vec4 sunColor;        // rgb
+    glm::vec4 cascadeSplits;   // View depth where each cascade ends
+    glm::mat4 viewToShadow[3]; // SHADOW_CASCADES
+};
+static_assert(offsetof(LightingUniforms, clusterCount) == 0, "LightingUniforms must match the std140 layout");
+static_assert(offsetof(LightingUniforms, sliceScaleBias) == 16, "LightingUniforms must match the std140 layout");
+static_assert(offsetof(LightingUniforms, ambient) == 32, "LightingUniforms must match the std140 layout");
+static_assert(offsetof(LightingUniforms, sunDirection) == 48, "LightingUniforms must match the std140 layout");
+static_assert(offsetof(LightingUniforms, sunColor) == 64, "LightingUniforms must match the std140 layout");
+static_assert(offsetof(LightingUniforms, cascadeSplits) == 80, "LightingUniforms must match the std140 layout");
+static_assert(offsetof(LightingUniforms, viewToShadow) == 96, "LightingUniforms must match the std140 layout");
+static_assert(sizeof(LightingUniforms) == 288, "LightingUniforms must match the std140 layout");
+
+// layout (std140) uniform Material
+struct MaterialUniforms {
+    glm::vec4 baseColor;
+};
+static_assert(sizeof(MaterialUniforms) == 16, "MaterialUniforms must match the std140 layout");
+
+// Name and offset of every member, for the reflection check. Arrays are
+// named by their first element, the way glGetUniformIndices expects.
+struct UniformBlockMember {
+    const char* name;
+    size_t offset;
+};
+
+struct UniformBlockDesc {
+    const char* name;
+    uint32_t binding;
+    size_t size;
+    const UniformBlockMember* members;
+    size_t memberCount;
+};
+
+inline const UniformBlockDesc* uniformBlockDescs(size_t& count) {
+    static const UniformBlockMember frameMembers[] = {
+        { "view", offsetof(FrameUniforms, view) },
+        { "projection", offsetof(FrameUniforms, projection) },
+        { "viewProjection", offsetof(FrameUniforms, viewProjection) },
+        { "inverseProjection", offsetof(FrameUniforms, inverseProjection) },
+        { "viewportTime", offsetof(FrameUniforms, viewportTime) },
+    };
+    static const UniformBlockMember lightingMembers[] = {
+        { "clusterCount", offsetof(LightingUniforms, clusterCount) },
+        { "sliceScaleBias", offsetof(LightingUniforms, sliceScaleBias) },
+        { "ambient", offsetof(LightingUniforms, ambient) },
+        { "sunDirection", offsetof(LightingUniforms, sunDirection) },
+        { "sunColor", offsetof(LightingUniforms, sunColor) },
+        { "cascadeSplits", offsetof(LightingUniforms, cascadeSplits) },
+        { "viewToShadow[0]", offsetof(LightingUniforms, viewToShadow) },
+    };
+    static const UniformBlockMember materialMembers[] = {
+        { "baseColor", offsetof(MaterialUniforms, baseColor) },
+    };
+    static const UniformBlockDesc blocks[] = {
+        { "Frame", FRAME_BLOCK_BINDING, sizeof(FrameUniforms), frameMembers,
+            sizeof(frameMembers) / sizeof(frameMembers[0]) },
+        { "Lighting", LIGHTING_BLOCK_BINDING, sizeof(LightingUniforms), lightingMembers,
+            sizeof(lightingMembers) / sizeof(lightingMembers[0]) },
+        { "Material", MATERIAL_BLOCK_BINDING, sizeof(MaterialUniforms), materialMembers,
+            sizeof(materialMembers) / sizeof(materialMembers[0]) },
+    };
+    count = sizeof(blocks) / sizeof(blocks[0]);
+    return blocks;
+}
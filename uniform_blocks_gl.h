@@ -0,0 +1,138 @@
+#pragma once
+
+// GL side of uniform_blocks.h: block binding and layout check at link time,
+// per-frame buffers written once per frame, and the material table.
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include "gl_resources.h"
+#include "uniform_blocks.h"
+
+// Point the program's blocks at their binding points (GLSL 3.30 has no
+// layout(binding) for blocks) and check every member offset against the C++
+// structs. Returns false on a mismatch.
+inline bool bindUniformBlocks(GLuint program) {
+    bool matches = true;
+    size_t blockCount = 0;
+    const UniformBlockDesc* blocks = uniformBlockDescs(blockCount);
+    for (size_t b = 0; b < blockCount; ++b) {
+        const UniformBlockDesc& block = blocks[b];
+        GLuint blockIndex = glGetUniformBlockIndex(program, block.name);
+        if (blockIndex == GL_INVALID_INDEX)
+            continue;
+        glUniformBlockBinding(program, blockIndex, block.binding);
+
+        GLint size = 0;
+        glGetActiveUniformBlockiv(program, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+        if (static_cast<size_t>(size) != block.size) {
+            std::cerr << "ERROR::SHADER::UNIFORM_BLOCK " << block.name << " is " << size << " bytes, expected "
+                << block.size << std::endl;
+            matches = false;
+        }
+        for (size_t m = 0; m < block.memberCount; ++m) {
+            const char* name = block.members[m].name;
+            GLuint index = GL_INVALID_INDEX;
+            glGetUniformIndices(program, 1, &name, &index);
+            if (index == GL_INVALID_INDEX) {
+                std::cerr << "ERROR::SHADER::UNIFORM_BLOCK " << block.name << " has no " << name << std::endl;
+                matches = false;
+                continue;
+            }
+            GLint offset = -1;
+            glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_OFFSET, &offset);
+            if (static_cast<size_t>(offset) != block.members[m].offset) {
+                std::cerr << "ERROR::SHADER::UNIFORM_BLOCK " << block.name << "." << name << " at " << offset
+                    << ", expected " << block.members[m].offset << std::endl;
+                matches = false;
+            }
+        }
+    }
+    return matches;
+}
+
+// One block of per-frame data: upload() once a frame, every program bound
+// to `binding` reads it
+template <typename T>
+class UniformBlockBuffer {
+public:
+    void init(GLuint bindingPoint) {
+        binding = bindingPoint;
+        GLint alignment = 256;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        buffer.init(static_cast<size_t>(alignment));
+    }
+
+    // Writes the next slice, so the GPU can still be reading last frame's
+    void upload(const T& data) {
+        buffer.begin(sizeof(T));
+        buffer.write(0, &data, sizeof(T));
+        bind();
+    }
+
+    // Bind again after something else used the binding point
+    void bind() const {
+        glBindBufferRange(GL_UNIFORM_BUFFER, binding, buffer.id(), static_cast<GLintptr>(buffer.offset()), sizeof(T));
+    }
+
+    void destroy() {
+        buffer.destroy();
+        *this = UniformBlockBuffer();
+    }
+
+private:
+    StreamBuffer buffer;
+    GLuint binding = 0;
+};
+
+// Every material of the scene in one static buffer. Slots are padded to the
+// driver's offset alignment so a draw can bind its own with glBindBufferRange.
+// Slot 0 is plain white.
+class MaterialTable {
+public:
+    MaterialTable() {
+        add(glm::vec4(1.0f));
+    }
+
+    // Slot index of this material, shared with equal ones added before
+    uint32_t add(const glm::vec4& baseColor) {
+        for (uint32_t i = 0; i < materials.size(); ++i) {
+            if (materials[i].baseColor == baseColor)
+                return i;
+        }
+        materials.push_back({ baseColor });
+        return static_cast<uint32_t>(materials.size() - 1);
+    }
+
+    // After the last add()
+    void upload() {
+        GLint alignment = 256;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        stride = static_cast<uint32_t>(std::max<size_t>(sizeof(MaterialUniforms), static_cast<size_t>(alignment)));
+        std::vector<unsigned char> data(stride * materials.size(), 0);
+        for (size_t i = 0; i < materials.size(); ++i)
+            std::copy_n(reinterpret_cast<const unsigned char*>(&materials[i]), sizeof(MaterialUniforms),
+                data.begin() + i * stride);
+        buffer = createBuffer(data.size(), data.data());
+    }
+
+    GLuint bufferId() const { return buffer; }
+    uint32_t offset(uint32_t slot) const { return slot * stride; }
+
+    void bind(uint32_t slot) const {
+        glBindBufferRange(GL_UNIFORM_BUFFER, MATERIAL_BLOCK_BINDING, buffer, offset(slot), sizeof(MaterialUniforms));
+    }
+
+    size_t size() const { return materials.size(); }
+
+    void destroy() {
+        glDeleteBuffers(1, &buffer);
+        *this = MaterialTable();
+    }
+
+private:
+    std::vector<MaterialUniforms> materials;
+    GLuint buffer = 0;
+    uint32_t stride = 0;
+};
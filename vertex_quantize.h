@@ -0,0 +1,145 @@
+#pragma once
+
+// Quantized 16-byte vertex layouts, built with glm/gtc/packing:
+//   position: 4 x snorm16 relative to the mesh bounds, or 4 x half float
+//   color:    unorm8 x 4
+//   normal:   octahedral encoding, snorm16 x 2
+// All three are fetched as normalized (or half) attributes, so the vertex
+// shader gets floats without any unpacking code. Snorm16 positions cover
+// [-1, 1] over the bounding box; positionDecodeMatrix() maps them back and
+// is folded into the model matrix. Normals need OCTAHEDRAL_DECODE_GLSL.
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "job_system.h"
+#include "mesh.h"
+#include "mesh_format.h"
+
+struct QuantizedVertex {
+    uint16_t position[4]; // xyz + padding (1.0), snorm16 or half depending on the format
+    uint32_t color;       // packUnorm4x8
+    uint32_t normal;      // packSnorm2x16 of the octahedral encoding
+};
+static_assert(sizeof(QuantizedVertex) == 16, "QuantizedVertex must match the GPU layout");
+static_assert(sizeof(QuantizedVertex) == vertexFormatStride(static_cast<uint32_t>(VertexFormat::QuantizedHalf)),
+    "QuantizedVertex must match the .pmesh vertex stride");
+
+inline bool isQuantized(VertexFormat format) {
+    return format == VertexFormat::QuantizedSnorm16 || format == VertexFormat::QuantizedHalf;
+}
+
+// Octahedral normal encoding: the unit sphere folded onto [-1, 1]^2
+inline glm::vec2 octEncode(glm::vec3 n) {
+    n /= std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+    glm::vec2 p(n.x, n.y);
+    if (n.z < 0.0f) {
+        p = glm::vec2((1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+            (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f));
+    }
+    return p;
+}
+
+inline glm::vec3 octDecode(glm::vec2 e) {
+    glm::vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+    float t = std::max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return glm::normalize(n);
+}
+
+// GLSL twin of octDecode for shaders that read attribute 2
+const char* const OCTAHEDRAL_DECODE_GLSL = R"glsl(
+    vec3 octDecode(vec2 e) {
+        vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+        float t = max(-n.z, 0.0);
+        n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+        return normalize(n);
+    }
+)glsl";
+
+// Maps the stored positions of `format` back into mesh space
+inline glm::mat4 positionDecodeMatrix(VertexFormat format, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    if (format != VertexFormat::QuantizedSnorm16)
+        return glm::mat4(1.0f);
+    glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+    glm::vec3 extent = glm::max((boundsMax - boundsMin) * 0.5f, glm::vec3(1e-20f));
+    return glm::scale(glm::translate(glm::mat4(1.0f), center), extent);
+}
+
+// Area-weighted vertex normals; the input layout has none
+inline std::vector<glm::vec3> computeVertexNormals(const MeshData& mesh) {
+    std::vector<glm::vec3> normals(mesh.vertices.size(), glm::vec3(0.0f));
+    for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        uint32_t a = mesh.indices[i], b = mesh.indices[i + 1], c = mesh.indices[i + 2];
+        glm::vec3 faceNormal = glm::cross(mesh.vertices[b].position - mesh.vertices[a].position,
+            mesh.vertices[c].position - mesh.vertices[a].position);
+        normals[a] += faceNormal;
+        normals[b] += faceNormal;
+        normals[c] += faceNormal;
+    }
+    return normals;
+}
+
+struct QuantizationError {
+    float maxPosition = 0.0f;     // Largest position error in mesh units
+    float maxNormalDegrees = 0.0f;
+};
+
+// Pack `mesh` into `format`. Vertices are packed in parallel; the error of
+// the round trip is measured on the way.
+inline QuantizationError quantizeMesh(const MeshData& mesh, VertexFormat format, JobSystem& jobs,
+    std::vector<QuantizedVertex>& out) {
+    std::vector<glm::vec3> normals = computeVertexNormals(mesh);
+    glm::mat4 decode = positionDecodeMatrix(format, mesh.boundsMin, mesh.boundsMax);
+    glm::mat4 encode = glm::inverse(decode);
+    out.resize(mesh.vertices.size());
+
+    const size_t grain = 64 * 1024;
+    std::vector<QuantizationError> chunkErrors((mesh.vertices.size() + grain - 1) / grain);
+    jobs.parallelFor("quantize", 0, mesh.vertices.size(), grain, [&](size_t begin, size_t end) {
+        QuantizationError& error = chunkErrors[begin / grain];
+        for (size_t i = begin; i < end; ++i) {
+            const Vertex& vertex = mesh.vertices[i];
+            QuantizedVertex& packed = out[i];
+            glm::vec3 decoded;
+            if (format == VertexFormat::QuantizedSnorm16) {
+                glm::vec3 local(encode * glm::vec4(vertex.position, 1.0f));
+                for (int c = 0; c < 3; ++c)
+                    packed.position[c] = glm::packSnorm1x16(local[c]);
+                packed.position[3] = glm::packSnorm1x16(1.0f);
+                glm::vec3 unpacked(glm::unpackSnorm1x16(packed.position[0]), glm::unpackSnorm1x16(packed.position[1]),
+                    glm::unpackSnorm1x16(packed.position[2]));
+                decoded = glm::vec3(decode * glm::vec4(unpacked, 1.0f));
+            } else {
+                for (int c = 0; c < 3; ++c)
+                    packed.position[c] = glm::packHalf1x16(vertex.position[c]);
+                packed.position[3] = glm::packHalf1x16(1.0f);
+                decoded = glm::vec3(glm::unpackHalf1x16(packed.position[0]), glm::unpackHalf1x16(packed.position[1]),
+                    glm::unpackHalf1x16(packed.position[2]));
+            }
+            error.maxPosition = std::max(error.maxPosition, glm::length(decoded - vertex.position));
+
+            packed.color = glm::packUnorm4x8(glm::vec4(vertex.color, 1.0f));
+
+            glm::vec3 normal = normals[i];
+            float length = glm::length(normal);
+            normal = length > 0.0f ? normal / length : glm::vec3(0.0f, 0.0f, 1.0f);
+            packed.normal = glm::packSnorm2x16(octEncode(normal));
+            float cosine = glm::dot(normal, octDecode(glm::unpackSnorm2x16(packed.normal)));
+            error.maxNormalDegrees = std::max(error.maxNormalDegrees,
+                glm::degrees(std::acos(std::min(std::max(cosine, -1.0f), 1.0f))));
+        }
+    });
+
+    QuantizationError total;
+    for (const QuantizationError& error : chunkErrors) {
+        total.maxPosition = std::max(total.maxPosition, error.maxPosition);
+        total.maxNormalDegrees = std::max(total.maxNormalDegrees, error.maxNormalDegrees);
+    }
+    return total;
+}
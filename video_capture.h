@@ -0,0 +1,121 @@
+#pragma once
+
+// Video stream of captured frames for offline review. Frames arrive from the
+// asynchronous readback (frame_capture_gl.h) on the writer thread, are
+// converted to planar 4:2:0 with the SIMD kernels of
+// gtx/color_space_YCoCg and appended to one file. A .y4m file gets a
+// YUV4MPEG2 header that players and ffmpeg read directly; any other name
+// gets the bare planes, frame after frame.
+//
+// The stream keeps the size of its first frame: odd sizes are cropped to
+// even, and frames of another size (after a resize) are skipped. The header
+// promises a constant frame rate, so every tick without a picture, whether
+// skipped here or dropped by the capture queue, repeats the previous one.
+
+#ifndef GLM_ENABLE_EXPERIMENTAL
+#define GLM_ENABLE_EXPERIMENTAL
+#endif
+#include <glm/gtx/color_space_YCoCg.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "frame_capture.h"
+
+enum class VideoFormat {
+    Yuv420,  // Full range BT.601 YCbCr, Y4M's C420jpeg
+    YCoCg420 // YCoCg in the same planes, tagged XCOLORSPACE=YCOCG in the Y4M header
+};
+
+class VideoStream {
+public:
+    // `ticksPerFrame`: distance between the frame numbers of two consecutive
+    // video frames (--capture-every)
+    bool open(const std::string& path, VideoFormat videoFormat, int framesPerSecond, uint32_t ticksPerFrame = 1) {
+        file.open(path, std::ios::binary);
+        format = videoFormat;
+        fps = framesPerSecond > 0 ? framesPerSecond : 60;
+        frameStep = std::max<uint32_t>(ticksPerFrame, 1);
+        y4m = path.size() >= 4 && path.compare(path.size() - 4, 4, ".y4m") == 0;
+        return static_cast<bool>(file);
+    }
+
+    // Writer thread only
+    bool write(const CapturedFrame& frame) {
+        uint32_t frameWidth = frame.width & ~1u, frameHeight = frame.height & ~1u;
+        if (width == 0) {
+            if (frameWidth == 0 || frameHeight == 0)
+                return false;
+            width = frameWidth;
+            height = frameHeight;
+            planes.resize(static_cast<size_t>(width) * height * 3 / 2);
+            if (y4m)
+                file << "YUV4MPEG2 W" << width << " H" << height << " F" << fps << ":1 Ip A1:1 C420jpeg"
+                    << (format == VideoFormat::YCoCg420 ? " XCOLORSPACE=YCOCG" : "") << "\n";
+        }
+        // Frames the capture dropped between the last one and this
+        if (written > 0 && frame.frame > lastFrame) {
+            for (uint64_t missing = (frame.frame - lastFrame) / frameStep; missing > 1; --missing)
+                repeatLast();
+        }
+        lastFrame = frame.frame;
+        if (frameWidth != width || frameHeight != height) {
+            ++skipped;
+            repeatLast();
+            return static_cast<bool>(file);
+        }
+
+        // The bottom `height` rows of the bottom-up image, so a cropped row is the top one
+        size_t stride = static_cast<size_t>(frame.width) * 4;
+        glm::uint8* y = planes.data();
+        glm::uint8* c0 = y + static_cast<size_t>(width) * height;
+        glm::uint8* c1 = c0 + static_cast<size_t>(width / 2) * (height / 2);
+        if (format == VideoFormat::Yuv420)
+            glm::rgba8ToYCbCr420(frame.pixels.data(), stride, static_cast<glm::length_t>(width),
+                static_cast<glm::length_t>(height), true, y, c0, c1);
+        else
+            glm::rgba8ToYCoCg420(frame.pixels.data(), stride, static_cast<glm::length_t>(width),
+                static_cast<glm::length_t>(height), true, y, c0, c1);
+        writePlanes();
+        return static_cast<bool>(file);
+    }
+
+    uint32_t frameWidth() const { return width; }
+    uint32_t frameHeight() const { return height; }
+    uint64_t skippedCount() const { return skipped; }
+    // Frames written again in place of dropped or skipped ones
+    uint64_t repeatedCount() const { return repeated; }
+
+private:
+    void writePlanes() {
+        if (y4m)
+            file << "FRAME\n";
+        file.write(reinterpret_cast<const char*>(planes.data()), static_cast<std::streamsize>(planes.size()));
+        ++written;
+    }
+
+    void repeatLast() {
+        writePlanes();
+        ++repeated;
+    }
+
+    std::ofstream file;
+    VideoFormat format = VideoFormat::Yuv420;
+    int fps = 60;
+    bool y4m = false;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<glm::uint8> planes; // Y, then the two chroma planes
+    uint32_t frameStep = 1;
+    uint64_t lastFrame = 0;
+    uint64_t written = 0;
+    uint64_t skipped = 0;
+    uint64_t repeated = 0;
+};
+
+// Sink appending every frame to `stream`; the caller keeps the stream for its statistics
+inline CaptureSink videoSink(std::shared_ptr<VideoStream> stream) {
+    return [stream](const CapturedFrame& frame) { return stream->write(frame); };
+}